@@ -0,0 +1,233 @@
+#include <vulkan/vulkan.hpp>
+
+#include <boost/format.hpp>
+
+#include <iostream>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Same dispatcher setup as the rendering library (see VulkanWindow.cxx)
+VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
+
+using Clock = std::chrono::steady_clock;
+
+static const int REPETITIONS = 10;
+
+/**
+ * Headless device with one graphics queue, enough to record commands and submit.
+ */
+struct Context {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkDevice device = VK_NULL_HANDLE;
+    VkQueue queue = VK_NULL_HANDLE;
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+};
+
+static void check(VkResult result, const char *what) {
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error(std::string(what) + " failed with VkResult " + std::to_string(result));
+    }
+}
+
+static Context createContext() {
+    Context context;
+
+    VkApplicationInfo appInfo = {VK_STRUCTURE_TYPE_APPLICATION_INFO};
+    appInfo.pApplicationName = "Dispatch Bench";
+    appInfo.apiVersion = VK_API_VERSION_1_2;
+
+    VkInstanceCreateInfo instanceInfo = {VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO};
+    instanceInfo.pApplicationInfo = &appInfo;
+    check(vkCreateInstance(&instanceInfo, nullptr, &context.instance), "vkCreateInstance");
+
+    uint32_t deviceCount = 0;
+    vkEnumeratePhysicalDevices(context.instance, &deviceCount, nullptr);
+    std::vector<VkPhysicalDevice> devices(deviceCount);
+    vkEnumeratePhysicalDevices(context.instance, &deviceCount, devices.data());
+
+    if (devices.empty()) {
+        throw std::runtime_error("No Vulkan devices found.");
+    }
+
+    // The per-call overhead is most visible on a software driver, so prefer one if present
+    context.physicalDevice = devices[0];
+    for (auto device : devices) {
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(device, &properties);
+
+        if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) {
+            context.physicalDevice = device;
+            break;
+        }
+    }
+
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(context.physicalDevice, &properties);
+    std::cout << boost::format("Device: %s\n") % properties.deviceName;
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(context.physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(context.physicalDevice, &familyCount, families.data());
+
+    uint32_t family = UINT32_MAX;
+    for (uint32_t i = 0; i < familyCount; i++) {
+        if (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            family = i;
+            break;
+        }
+    }
+
+    if (family == UINT32_MAX) {
+        throw std::runtime_error("No graphics queue family found.");
+    }
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+    queueInfo.queueFamilyIndex = family;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo deviceInfo = {VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+    deviceInfo.queueCreateInfoCount = 1;
+    deviceInfo.pQueueCreateInfos = &queueInfo;
+    check(vkCreateDevice(context.physicalDevice, &deviceInfo, nullptr, &context.device), "vkCreateDevice");
+
+    vkGetDeviceQueue(context.device, family, 0, &context.queue);
+
+    VkCommandPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = family;
+    check(vkCreateCommandPool(context.device, &poolInfo, nullptr, &context.commandPool), "vkCreateCommandPool");
+
+    VkCommandBufferAllocateInfo allocateInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocateInfo.commandPool = context.commandPool;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = 1;
+    check(vkAllocateCommandBuffers(context.device, &allocateInfo, &context.commandBuffer), "vkAllocateCommandBuffers");
+
+    VkFenceCreateInfo fenceInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+    fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+    check(vkCreateFence(context.device, &fenceInfo, nullptr, &context.fence), "vkCreateFence");
+
+    return context;
+}
+
+static void destroyContext(Context& context) {
+    vkDeviceWaitIdle(context.device);
+    vkDestroyFence(context.device, context.fence, nullptr);
+    vkDestroyCommandPool(context.device, context.commandPool, nullptr);
+    vkDestroyDevice(context.device, nullptr);
+    vkDestroyInstance(context.instance, nullptr);
+}
+
+/**
+ * Runs `body` REPETITIONS times and returns the best time per call in nanoseconds.
+ */
+template<typename Setup, typename Body, typename Teardown>
+static double bestNsPerCall(size_t calls, Setup&& setup, Body&& body, Teardown&& teardown) {
+    double best = 1e30;
+
+    for (int i = 0; i < REPETITIONS; i++) {
+        setup();
+
+        auto start = Clock::now();
+        for (size_t call = 0; call < calls; call++) {
+            body();
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+        teardown();
+
+        best = std::min(best, elapsed.count() / calls);
+    }
+
+    return best;
+}
+
+static void report(const char *name, double trampoline, double direct, double dispatcher) {
+    std::cout << boost::format("  %-22s %8.2f ns %8.2f ns %8.2f ns %8.2f ns\n")
+        % name % trampoline % direct % dispatcher % (trampoline - dispatcher);
+}
+
+int main() {
+    try {
+        Context context = createContext();
+
+        // Device-level entry points, as the rendering library's dispatcher loads them
+        auto cmdSetViewport = reinterpret_cast<PFN_vkCmdSetViewport>(
+            vkGetDeviceProcAddr(context.device, "vkCmdSetViewport"));
+        auto getFenceStatus = reinterpret_cast<PFN_vkGetFenceStatus>(
+            vkGetDeviceProcAddr(context.device, "vkGetFenceStatus"));
+        auto queueSubmit = reinterpret_cast<PFN_vkQueueSubmit>(
+            vkGetDeviceProcAddr(context.device, "vkQueueSubmit"));
+
+        // The path the renderer ships: vulkan.hpp calls through VULKAN_HPP_DEFAULT_DISPATCHER
+        VULKAN_HPP_DEFAULT_DISPATCHER.init(vkGetInstanceProcAddr);
+        VULKAN_HPP_DEFAULT_DISPATCHER.init(vk::Instance(context.instance));
+        VULKAN_HPP_DEFAULT_DISPATCHER.init(vk::Device(context.device));
+
+        vk::Device device(context.device);
+        vk::Queue queue(context.queue);
+        vk::CommandBuffer commandBuffer(context.commandBuffer);
+        vk::Fence fence(context.fence);
+        vk::Viewport hppViewport(0.0f, 0.0f, 800.0f, 600.0f, 0.0f, 1.0f);
+
+        VkViewport viewport = {0.0f, 0.0f, 800.0f, 600.0f, 0.0f, 1.0f};
+        VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+
+        auto beginRecording = [&]() {
+            vkResetCommandBuffer(context.commandBuffer, 0);
+            vkBeginCommandBuffer(context.commandBuffer, &beginInfo);
+        };
+        auto endRecording = [&]() {
+            vkEndCommandBuffer(context.commandBuffer);
+        };
+        auto nothing = []() {};
+
+        std::cout << boost::format("  %-22s %11s %11s %11s %11s\n")
+            % "call" % "loader" % "device" % "vulkan.hpp" % "saved";
+
+        const size_t recordCalls = 100000;
+        double trampoline = bestNsPerCall(recordCalls, beginRecording,
+            [&]() { vkCmdSetViewport(context.commandBuffer, 0, 1, &viewport); }, endRecording);
+        double direct = bestNsPerCall(recordCalls, beginRecording,
+            [&]() { cmdSetViewport(context.commandBuffer, 0, 1, &viewport); }, endRecording);
+        double dispatcher = bestNsPerCall(recordCalls, beginRecording,
+            [&]() { commandBuffer.setViewport(0, hppViewport); }, endRecording);
+        report("vkCmdSetViewport", trampoline, direct, dispatcher);
+
+        const size_t statusCalls = 1000000;
+        trampoline = bestNsPerCall(statusCalls, nothing,
+            [&]() { vkGetFenceStatus(context.device, context.fence); }, nothing);
+        direct = bestNsPerCall(statusCalls, nothing,
+            [&]() { getFenceStatus(context.device, context.fence); }, nothing);
+        dispatcher = bestNsPerCall(statusCalls, nothing,
+            [&]() { (void) device.getFenceStatus(fence); }, nothing);
+        report("vkGetFenceStatus", trampoline, direct, dispatcher);
+
+        // Zero-batch submits isolate the call itself from any GPU work
+        const size_t submitCalls = 10000;
+        trampoline = bestNsPerCall(submitCalls, nothing,
+            [&]() { vkQueueSubmit(context.queue, 0, nullptr, VK_NULL_HANDLE); }, nothing);
+        direct = bestNsPerCall(submitCalls, nothing,
+            [&]() { queueSubmit(context.queue, 0, nullptr, VK_NULL_HANDLE); }, nothing);
+        dispatcher = bestNsPerCall(submitCalls, nothing,
+            [&]() { queue.submit(nullptr, nullptr); }, nothing);
+        report("vkQueueSubmit (empty)", trampoline, direct, dispatcher);
+
+        destroyContext(context);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,161 @@
+#include <boost/format.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <MeshImporter.hxx>
+#include <MeshOptimizer.hxx>
+#include <MeshFile.hxx>
+#include <ThreadPool.hxx>
+
+using Clock = std::chrono::steady_clock;
+
+static const int REPETITIONS = 3;
+
+/**
+ * Writes a wavy grid with roughly the requested number of triangles as an OBJ file.
+ */
+static void writeSyntheticObj(const std::filesystem::path& filename, size_t triangles) {
+    size_t side = std::max<size_t>(2, static_cast<size_t>(std::sqrt(triangles / 2.0)) + 1);
+
+    std::ofstream file(filename);
+    file << "# synthetic grid " << side << "x" << side << "\n";
+
+    for (size_t y = 0; y < side; y++) {
+        for (size_t x = 0; x < side; x++) {
+            float u = static_cast<float>(x) / (side - 1);
+            float v = static_cast<float>(y) / (side - 1);
+            float height = 0.05f * std::sin(u * 40.0f) * std::cos(v * 40.0f);
+
+            file << "v " << u << " " << height << " " << v << "\n";
+            file << "vt " << u << " " << v << "\n";
+        }
+    }
+
+    file << "vn 0 1 0\n";
+
+    for (size_t y = 0; y + 1 < side; y++) {
+        for (size_t x = 0; x + 1 < side; x++) {
+            size_t i0 = y * side + x + 1;
+            size_t i1 = i0 + 1;
+            size_t i2 = i0 + side;
+            size_t i3 = i2 + 1;
+
+            file << boost::format("f %1%/%1%/1 %3%/%3%/1 %2%/%2%/1\n") % i0 % i1 % i2;
+            file << boost::format("f %1%/%1%/1 %3%/%3%/1 %2%/%2%/1\n") % i1 % i3 % i2;
+        }
+    }
+}
+
+template<typename Function>
+static double bestOf(Function&& function) {
+    double best = 1e30;
+
+    for (int i = 0; i < REPETITIONS; i++) {
+        auto start = Clock::now();
+        function();
+        std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+        best = std::min(best, elapsed.count());
+    }
+
+    return best;
+}
+
+static void benchmark(size_t triangles, const std::filesystem::path& directory) {
+    auto objPath = directory / (boost::format("synthetic_%d.obj") % triangles).str();
+    auto meshPath = directory / (boost::format("synthetic_%d.mesh") % triangles).str();
+
+    writeSyntheticObj(objPath, triangles);
+    double objMiB = std::filesystem::file_size(objPath) / (1024.0 * 1024.0);
+
+    std::cout << boost::format("\n%d triangles requested, OBJ is %.1f MiB\n") % triangles % objMiB;
+
+    // Parse scaling across worker counts
+    std::vector<size_t> threadCounts;
+    size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+    for (size_t threads = 1; threads < hardwareThreads; threads *= 2) {
+        threadCounts.push_back(threads);
+    }
+    threadCounts.push_back(hardwareThreads);
+
+    MeshData mesh;
+    double singleThreaded = 0.0;
+
+    for (size_t threads : threadCounts) {
+        ThreadPool pool(threads);
+        double ms = bestOf([&]() { mesh = MeshImporter::importObj(objPath, pool); });
+
+        if (threads == 1) {
+            singleThreaded = ms;
+        }
+
+        std::cout << boost::format("  import  %2d threads %10.2f ms %8.1f MiB/s  x%.2f\n")
+            % threads % ms % (objMiB / (ms / 1000.0)) % (singleThreaded / ms);
+    }
+
+    std::cout << boost::format("  %d vertices, %d indices\n") % mesh.vertices.size() % mesh.indices.size();
+
+    MeshData optimized;
+    double optimizeMs = bestOf([&]() {
+        optimized = mesh;
+        MeshOptimizer::optimize(optimized);
+    });
+    std::cout << boost::format("  optimize           %10.2f ms\n") % optimizeMs;
+
+    double writeMs = bestOf([&]() { MeshFile::write(meshPath, optimized); });
+    std::cout << boost::format("  write              %10.2f ms\n") % writeMs;
+
+    // Map the binary file and touch every page, as an upload would
+    uint64_t checksum = 0;
+    double loadMs = bestOf([&]() {
+        MeshFile file(meshPath);
+
+        const uint32_t *indices = file.indices();
+        for (uint32_t i = 0; i < file.indexCount(); i += 1024) {
+            checksum += indices[i];
+        }
+
+        const char *vertices = reinterpret_cast<const char*>(file.vertices());
+        for (size_t offset = 0; offset < file.vertexBytes(); offset += 4096) {
+            checksum += static_cast<unsigned char>(vertices[offset]);
+        }
+    });
+
+    double meshMiB = std::filesystem::file_size(meshPath) / (1024.0 * 1024.0);
+    std::cout << boost::format("  map binary         %10.2f ms %8.1f MiB/s  (%.1f MiB, checksum %x)\n")
+        % loadMs % (meshMiB / (loadMs / 1000.0)) % meshMiB % checksum;
+
+    std::filesystem::remove(objPath);
+    std::filesystem::remove(meshPath);
+}
+
+int main(int argc, char **argv) {
+    std::vector<size_t> sizes;
+
+    for (int i = 1; i < argc; i++) {
+        sizes.push_back(std::stoull(argv[i]));
+    }
+
+    if (sizes.empty()) {
+        sizes = {1 << 18, 1 << 20, 1 << 22};
+    }
+
+    auto directory = std::filesystem::temp_directory_path();
+
+    try {
+        for (size_t triangles : sizes) {
+            benchmark(triangles, directory);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+#include <boost/format.hpp>
+
+#include <iostream>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+#include <SpscQueue.hxx>
+
+using Clock = std::chrono::steady_clock;
+
+static const size_t QUEUE_CAPACITY = 1024;
+static const uint64_t DEFAULT_ELEMENTS = 5000000;
+
+/**
+ * Streams a sequence of numbers from a producer thread to a consumer thread and checks that every
+ * one arrives exactly once and in order. Built with ENABLE_TSAN this doubles as the data race check
+ * for the render thread's input queue.
+ */
+int main(int argc, char **argv) {
+    uint64_t elements = argc > 1 ? std::stoull(argv[1]) : DEFAULT_ELEMENTS;
+
+    SpscQueue<uint64_t, QUEUE_CAPACITY> queue;
+    uint64_t fullRetries = 0;
+
+    auto start = Clock::now();
+
+    std::thread producer([&]() {
+        for (uint64_t i = 0; i < elements; i++) {
+            while (!queue.tryPush(i)) {
+                fullRetries++;
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint64_t expected = 0;
+    uint64_t value;
+
+    while (expected < elements) {
+        if (!queue.tryPop(value)) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (value != expected) {
+            std::cerr << boost::format("Expected %d but received %d") % expected % value << std::endl;
+            producer.join();
+            return EXIT_FAILURE;
+        }
+
+        expected++;
+    }
+
+    producer.join();
+
+    std::chrono::duration<double, std::milli> elapsed = Clock::now() - start;
+    std::cout << boost::format("%d elements in %.2f ms (%.1f M/s), producer found the queue full %d times\n")
+        % elements % elapsed.count() % (elements / (elapsed.count() * 1000.0)) % fullRetries;
+
+    return EXIT_SUCCESS;
+}
@@ -5,27 +5,76 @@ extern "C" {
 
 #include <iostream>
 #include <stdexcept>
-#include <thread>
 #include <chrono>
 #include <cstdlib>
 
 #include <VulkanWindow.hxx>
+#include <RenderThread.hxx>
+
+// Minimum time between frames, roughly 60 frames per second
+static const std::chrono::microseconds FRAME_INTERVAL(16667);
+
+static void forwardInput(GLFWwindow *window, const InputEvent& event) {
+    auto renderThread = static_cast<RenderThread*>(glfwGetWindowUserPointer(window));
+    renderThread->pushInput(event);
+}
+
+static void keyCallback(GLFWwindow *window, int key, int, int action, int) {
+    InputEvent event;
+    event.type = InputEvent::Type::Key;
+    event.code = key;
+    event.action = action;
+    event.time = std::chrono::steady_clock::now();
+
+    forwardInput(window, event);
+}
+
+static void mouseButtonCallback(GLFWwindow *window, int button, int action, int) {
+    InputEvent event;
+    event.type = InputEvent::Type::MouseButton;
+    event.code = button;
+    event.action = action;
+    event.time = std::chrono::steady_clock::now();
+
+    forwardInput(window, event);
+}
+
+static void cursorPosCallback(GLFWwindow *window, double x, double y) {
+    InputEvent event;
+    event.type = InputEvent::Type::CursorMove;
+    event.x = x;
+    event.y = y;
+    event.time = std::chrono::steady_clock::now();
+
+    forwardInput(window, event);
+}
 
 int main() {
     VulkanWindow *vkWindow = new VulkanWindow(800, 600, "Vulkan Window");
 
+    // From here on the render thread owns the device; this thread only handles window events.
+    RenderThread *renderThread = new RenderThread(vkWindow, FRAME_INTERVAL);
+
+    glfwSetWindowUserPointer(vkWindow->window(), renderThread);
+    glfwSetKeyCallback(vkWindow->window(), keyCallback);
+    glfwSetMouseButtonCallback(vkWindow->window(), mouseButtonCallback);
+    glfwSetCursorPosCallback(vkWindow->window(), cursorPosCallback);
+
+    int status = EXIT_SUCCESS;
+
     try {
-        while(!glfwWindowShouldClose(vkWindow->window())) {
-            glfwPollEvents();
-            vkWindow->drawFrame();
-            vkWindow->logicalDevice()->waitIdle();
-            std::this_thread::sleep_for(std::chrono::milliseconds(17));
+        while (!glfwWindowShouldClose(vkWindow->window()) && renderThread->running()) {
+            glfwWaitEvents();
         }
+
+        renderThread->stop();
     } catch (const std::exception& e) {
         std::cerr << e.what() << std::endl;
-        return EXIT_FAILURE;
+        status = EXIT_FAILURE;
     }
 
+    // The render thread has to go first: it still uses the window's device until it is stopped
+    delete renderThread;
     delete vkWindow;
-    return EXIT_SUCCESS;
-}
\ No newline at end of file
+    return status;
+}
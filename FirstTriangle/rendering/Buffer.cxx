@@ -0,0 +1,105 @@
+#include <iostream>
+#include <set>
+
+#include "Buffer.hxx"
+
+Buffer::Buffer(vk::PhysicalDevice physicalDevice, vk::Device *logicalDevice, vk::DeviceSize size,
+    vk::BufferUsageFlags usage, const std::vector<vk::MemoryPropertyFlags>& preferredProperties,
+    const std::vector<uint32_t>& queueFamilies) {
+    m_logicalDevice = logicalDevice;
+    m_size = size;
+
+    std::set<uint32_t> uniqueFamilies(queueFamilies.begin(), queueFamilies.end());
+    std::vector<uint32_t> familyIndices(uniqueFamilies.begin(), uniqueFamilies.end());
+
+    vk::BufferCreateInfo createInfo({}, m_size, usage, vk::SharingMode::eExclusive);
+
+    if (familyIndices.size() > 1) {
+        createInfo.sharingMode = vk::SharingMode::eConcurrent;
+        createInfo.queueFamilyIndexCount = static_cast<uint32_t>(familyIndices.size());
+        createInfo.pQueueFamilyIndices = familyIndices.data();
+    }
+
+    try {
+        m_buffer = m_logicalDevice->createBuffer(createInfo);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to create buffer." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+
+    vk::MemoryRequirements requirements = m_logicalDevice->getBufferMemoryRequirements(m_buffer);
+
+    std::optional<uint32_t> memoryType;
+    for (const auto& properties : preferredProperties) {
+        memoryType = findMemoryType(physicalDevice, requirements.memoryTypeBits, properties);
+
+        if (memoryType.has_value()) {
+            break;
+        }
+    }
+
+    if (!memoryType.has_value()) {
+        m_logicalDevice->destroyBuffer(m_buffer);
+        throw std::runtime_error("Failed to find a suitable memory type for buffer.");
+    }
+
+    m_memoryProperties = physicalDevice.getMemoryProperties().memoryTypes[memoryType.value()].propertyFlags;
+
+    vk::MemoryAllocateInfo allocateInfo(requirements.size, memoryType.value());
+
+    try {
+        m_memory = m_logicalDevice->allocateMemory(allocateInfo);
+        m_logicalDevice->bindBufferMemory(m_buffer, m_memory, 0);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to allocate buffer memory." << std::endl;
+        m_logicalDevice->destroyBuffer(m_buffer);
+        throw std::runtime_error(e.what());
+    }
+}
+
+Buffer::~Buffer() {
+    m_logicalDevice->destroyBuffer(m_buffer);
+    m_logicalDevice->freeMemory(m_memory);
+}
+
+vk::Buffer *Buffer::buffer() {
+    return &m_buffer;
+}
+
+vk::DeviceSize Buffer::size() {
+    return m_size;
+}
+
+vk::MemoryPropertyFlags Buffer::memoryProperties() {
+    return m_memoryProperties;
+}
+
+void *Buffer::map() {
+    return m_logicalDevice->mapMemory(m_memory, 0, VK_WHOLE_SIZE);
+}
+
+void Buffer::unmap() {
+    m_logicalDevice->unmapMemory(m_memory);
+}
+
+void Buffer::flush(vk::DeviceSize offset, vk::DeviceSize size) {
+    if (m_memoryProperties & vk::MemoryPropertyFlagBits::eHostCoherent) {
+        return;
+    }
+
+    vk::MappedMemoryRange range(m_memory, offset, size);
+    m_logicalDevice->flushMappedMemoryRanges(range);
+}
+
+std::optional<uint32_t> Buffer::findMemoryType(vk::PhysicalDevice physicalDevice, uint32_t typeFilter,
+    vk::MemoryPropertyFlags properties) {
+    vk::PhysicalDeviceMemoryProperties memProperties = physicalDevice.getMemoryProperties();
+
+    for (uint32_t i = 0; i < memProperties.memoryTypeCount; i++) {
+        if ((typeFilter & (1 << i)) && (memProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+            return i;
+        }
+    }
+
+    return std::nullopt;
+}
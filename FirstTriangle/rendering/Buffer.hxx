@@ -0,0 +1,62 @@
+#ifndef BUFFER_HXX
+#define BUFFER_HXX
+
+#include <vector>
+#include <optional>
+#include <vulkan/vulkan.hpp>
+
+class Buffer {
+public:
+    /**
+     * Creates a buffer and binds it to newly allocated memory.
+     *
+     * @param physicalDevice device used to look up memory types
+     * @param logicalDevice device that owns the buffer
+     * @param size size of the buffer in bytes
+     * @param usage buffer usage flags
+     * @param preferredProperties memory properties to try, in order of preference
+     * @param queueFamilies queue families that access the buffer; more than one enables concurrent sharing
+     */
+    Buffer(vk::PhysicalDevice physicalDevice, vk::Device *logicalDevice, vk::DeviceSize size,
+        vk::BufferUsageFlags usage, const std::vector<vk::MemoryPropertyFlags>& preferredProperties,
+        const std::vector<uint32_t>& queueFamilies = {});
+    ~Buffer();
+
+    vk::Buffer *buffer();
+    vk::DeviceSize size();
+
+    /**
+     * The properties of the memory type that was actually chosen.
+     */
+    vk::MemoryPropertyFlags memoryProperties();
+
+    /**
+     * Maps the whole buffer. Only valid for host-visible memory.
+     */
+    void *map();
+    void unmap();
+
+    /**
+     * Flushes host writes to the mapped range. Does nothing for host-coherent memory.
+     */
+    void flush(vk::DeviceSize offset = 0, vk::DeviceSize size = VK_WHOLE_SIZE);
+
+    /**
+     * Finds a memory type that satisfies both the resource's requirements and the requested properties.
+     *
+     * @param physicalDevice device to query
+     * @param typeFilter bitmask of acceptable memory types from vk::MemoryRequirements
+     * @param properties required memory properties
+     * @return the memory type index, if one exists
+     */
+    static std::optional<uint32_t> findMemoryType(vk::PhysicalDevice physicalDevice, uint32_t typeFilter,
+        vk::MemoryPropertyFlags properties);
+private:
+    vk::Device *m_logicalDevice;
+    vk::Buffer m_buffer;
+    vk::DeviceMemory m_memory;
+    vk::DeviceSize m_size;
+    vk::MemoryPropertyFlags m_memoryProperties;
+};
+
+#endif // BUFFER_HXX
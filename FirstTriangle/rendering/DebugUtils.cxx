@@ -0,0 +1,176 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+
+#include "DebugUtils.hxx"
+
+#ifdef RENDERING_DEBUG_UTILS
+
+bool DebugUtils::s_enabled = false;
+vk::DebugUtilsMessengerEXT DebugUtils::s_messenger;
+
+namespace {
+    const char *severityName(VkDebugUtilsMessageSeverityFlagBitsEXT severity) {
+        switch (severity) {
+            case VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT: return "verbose";
+            case VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT: return "info";
+            case VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT: return "warning";
+            case VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT: return "error";
+            default: return "unknown";
+        }
+    }
+
+    std::string typeNames(VkDebugUtilsMessageTypeFlagsEXT types) {
+        std::string names;
+
+        if (types & VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT) {
+            names += "general,";
+        }
+        if (types & VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT) {
+            names += "validation,";
+        }
+        if (types & VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT) {
+            names += "performance,";
+        }
+
+        if (!names.empty()) {
+            names.pop_back();
+        }
+
+        return names;
+    }
+
+    /**
+     * Quotes a value for a key="value" log field.
+     */
+    std::string quoted(const char *value) {
+        std::string result = "\"";
+
+        for (const char *c = value != nullptr ? value : ""; *c != '\0'; c++) {
+            if (*c == '"' || *c == '\\') {
+                result += '\\';
+            }
+
+            result += *c == '\n' ? ' ' : *c;
+        }
+
+        return result + "\"";
+    }
+
+    VkDebugUtilsMessageSeverityFlagsEXT severityFilter() {
+        const char *setting = std::getenv("RENDERING_DEBUG_SEVERITY");
+        std::string level = setting != nullptr ? setting : "warning";
+
+        VkDebugUtilsMessageSeverityFlagsEXT flags = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT;
+
+        if (level == "error") {
+            return flags;
+        }
+
+        flags |= VK_DEBUG_UTILS_MESSAGE_SEVERITY_WARNING_BIT_EXT;
+        if (level == "warning") {
+            return flags;
+        }
+
+        if (level != "info" && level != "verbose") {
+            std::clog << "Unknown RENDERING_DEBUG_SEVERITY \"" << level << "\", using warning." << std::endl;
+            return flags;
+        }
+
+        flags |= VK_DEBUG_UTILS_MESSAGE_SEVERITY_INFO_BIT_EXT;
+        if (level == "info") {
+            return flags;
+        }
+
+        return flags | VK_DEBUG_UTILS_MESSAGE_SEVERITY_VERBOSE_BIT_EXT;
+    }
+
+    VKAPI_ATTR VkBool32 VKAPI_CALL logMessage(VkDebugUtilsMessageSeverityFlagBitsEXT severity,
+        VkDebugUtilsMessageTypeFlagsEXT types, const VkDebugUtilsMessengerCallbackDataEXT *data, void *) {
+        // One line per message so that logs can be filtered and parsed
+        std::string line = "vulkan severity=" + std::string(severityName(severity)) +
+            " type=" + typeNames(types) +
+            " id=" + std::to_string(data->messageIdNumber) +
+            " name=" + quoted(data->pMessageIdName);
+
+        for (uint32_t i = 0; i < data->objectCount; i++) {
+            if (data->pObjects[i].pObjectName != nullptr) {
+                line += " object=" + quoted(data->pObjects[i].pObjectName);
+            }
+        }
+
+        for (uint32_t i = 0; i < data->cmdBufLabelCount; i++) {
+            line += " label=" + quoted(data->pCmdBufLabels[i].pLabelName);
+        }
+
+        line += " message=" + quoted(data->pMessage);
+
+        std::clog << line << std::endl;
+
+        return VK_FALSE;
+    }
+}
+
+void DebugUtils::addInstanceExtension(std::vector<const char*>& extensions) {
+    for (const auto& extension : vk::enumerateInstanceExtensionProperties()) {
+        if (std::strcmp(extension.extensionName, VK_EXT_DEBUG_UTILS_EXTENSION_NAME) == 0) {
+            extensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+            s_enabled = true;
+            return;
+        }
+    }
+
+    std::clog << "VK_EXT_debug_utils is not available; debug names and labels are disabled." << std::endl;
+}
+
+VkDebugUtilsMessengerCreateInfoEXT DebugUtils::messengerCreateInfo() {
+    VkDebugUtilsMessengerCreateInfoEXT createInfo = {};
+    createInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CREATE_INFO_EXT;
+    createInfo.messageSeverity = severityFilter();
+    createInfo.messageType = VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT |
+        VK_DEBUG_UTILS_MESSAGE_TYPE_VALIDATION_BIT_EXT | VK_DEBUG_UTILS_MESSAGE_TYPE_PERFORMANCE_BIT_EXT;
+    createInfo.pfnUserCallback = logMessage;
+
+    return createInfo;
+}
+
+void DebugUtils::createMessenger(vk::Instance instance) {
+    if (!s_enabled) {
+        return;
+    }
+
+    VkDebugUtilsMessengerCreateInfoEXT createInfo = messengerCreateInfo();
+
+    try {
+        s_messenger = instance.createDebugUtilsMessengerEXT(
+            reinterpret_cast<const vk::DebugUtilsMessengerCreateInfoEXT&>(createInfo));
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to create debug messenger." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+}
+
+void DebugUtils::destroyMessenger(vk::Instance instance) {
+    if (s_messenger) {
+        instance.destroyDebugUtilsMessengerEXT(s_messenger);
+        s_messenger = nullptr;
+    }
+}
+
+bool DebugUtils::enabled() {
+    return s_enabled;
+}
+
+void DebugUtils::setObjectName(vk::Device device, vk::ObjectType type, uint64_t handle, const char *name,
+    int64_t index) {
+    std::string fullName = name;
+
+    if (index >= 0) {
+        fullName += "[" + std::to_string(index) + "]";
+    }
+
+    device.setDebugUtilsObjectNameEXT(vk::DebugUtilsObjectNameInfoEXT(type, handle, fullName.c_str()));
+}
+
+#endif // RENDERING_DEBUG_UTILS
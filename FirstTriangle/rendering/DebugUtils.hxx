@@ -0,0 +1,118 @@
+#ifndef DEBUG_UTILS_HXX
+#define DEBUG_UTILS_HXX
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <vulkan/vulkan.hpp>
+
+#ifdef RENDERING_DEBUG_UTILS
+    static const bool ENABLE_DEBUG_UTILS = true;
+#else
+    static const bool ENABLE_DEBUG_UTILS = false;
+#endif // RENDERING_DEBUG_UTILS
+
+/**
+ * Opt-in VK_EXT_debug_utils support: a messenger that logs through std::clog, object names and
+ * command buffer labels.
+ *
+ * Built with RENDERING_DEBUG_UTILS (CMake option ENABLE_DEBUG_UTILS). Without it every call here is
+ * an empty inline function, defined below the class. With it, the calls still do nothing unless the
+ * instance extension was available.
+ */
+class DebugUtils {
+public:
+    /**
+     * Appends VK_EXT_debug_utils to the instance extensions if it is compiled in and supported.
+     *
+     * @param extensions instance extensions to enable
+     */
+    static void addInstanceExtension(std::vector<const char*>& extensions);
+
+    /**
+     * Messenger settings, also chained into vk::InstanceCreateInfo to cover instance creation itself.
+     *
+     * The minimum severity is read from RENDERING_DEBUG_SEVERITY (verbose, info, warning or error),
+     * defaulting to warning.
+     */
+    static VkDebugUtilsMessengerCreateInfoEXT messengerCreateInfo();
+
+    static void createMessenger(vk::Instance instance);
+    static void destroyMessenger(vk::Instance instance);
+
+    /**
+     * Whether debug utils calls reach the driver.
+     */
+    static bool enabled();
+
+    /**
+     * Names a Vulkan object for validation messages and capture tools.
+     *
+     * @param device device that owns the object
+     * @param handle object to name
+     * @param name name to give it
+     * @param index appended as name[index] when not negative
+     */
+    template<typename Handle>
+    static void setName(vk::Device device, Handle handle, const char *name, int64_t index = -1) {
+#ifdef RENDERING_DEBUG_UTILS
+        if (s_enabled) {
+            setObjectName(device, Handle::objectType, (uint64_t) static_cast<typename Handle::CType>(handle),
+                name, index);
+        }
+#else
+        (void) device;
+        (void) handle;
+        (void) name;
+        (void) index;
+#endif // RENDERING_DEBUG_UTILS
+    }
+
+    static void beginLabel(vk::CommandBuffer commandBuffer, const char *name,
+        const std::array<float, 4>& color = {1.0f, 1.0f, 1.0f, 1.0f}) {
+#ifdef RENDERING_DEBUG_UTILS
+        if (s_enabled) {
+            commandBuffer.beginDebugUtilsLabelEXT(vk::DebugUtilsLabelEXT(name, color));
+        }
+#else
+        (void) commandBuffer;
+        (void) name;
+        (void) color;
+#endif // RENDERING_DEBUG_UTILS
+    }
+
+    static void endLabel(vk::CommandBuffer commandBuffer) {
+#ifdef RENDERING_DEBUG_UTILS
+        if (s_enabled) {
+            commandBuffer.endDebugUtilsLabelEXT();
+        }
+#else
+        (void) commandBuffer;
+#endif // RENDERING_DEBUG_UTILS
+    }
+private:
+#ifdef RENDERING_DEBUG_UTILS
+    static bool s_enabled;
+    static vk::DebugUtilsMessengerEXT s_messenger;
+
+    static void setObjectName(vk::Device device, vk::ObjectType type, uint64_t handle, const char *name, int64_t index);
+#endif // RENDERING_DEBUG_UTILS
+};
+
+#ifndef RENDERING_DEBUG_UTILS
+inline void DebugUtils::addInstanceExtension(std::vector<const char*>&) {}
+
+inline VkDebugUtilsMessengerCreateInfoEXT DebugUtils::messengerCreateInfo() {
+    return {};
+}
+
+inline void DebugUtils::createMessenger(vk::Instance) {}
+
+inline void DebugUtils::destroyMessenger(vk::Instance) {}
+
+inline bool DebugUtils::enabled() {
+    return false;
+}
+#endif // RENDERING_DEBUG_UTILS
+
+#endif // DEBUG_UTILS_HXX
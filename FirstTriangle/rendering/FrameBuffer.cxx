@@ -9,7 +9,7 @@ FrameBuffer::FrameBuffer(vk::Device *logicalDevice, vk::ImageView *imageView, vk
         swapChainExtent.width, swapChainExtent.height, 1);
 
     try {
-        m_logicalDevice->createFramebuffer(&createInfo, {}, &m_buffer, {});
+        m_logicalDevice->createFramebuffer(&createInfo, {}, &m_buffer);
     } catch (std::system_error e) {
         std::cerr << "Failed to create framebuffer." << std::endl;
         throw std::runtime_error(e.what());
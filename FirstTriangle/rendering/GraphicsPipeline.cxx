@@ -1,12 +1,49 @@
 #include <fstream>
 
 #include "GraphicsPipeline.hxx"
+#include "DebugUtils.hxx"
 
 // TODO: Complete these as I build the pipeline
-GraphicsPipeline::GraphicsPipeline(Device *logicalDevice, Extent2D *swapchainExtent, RenderPass *renderPass) {
+GraphicsPipeline::GraphicsPipeline(Device *logicalDevice, Extent2D *swapchainExtent, RenderPass *renderPass,
+    DescriptorSetLayout *setLayout, const SpecializationInfo *vertSpecialization,
+    const SpecializationInfo *fragSpecialization) {
     m_logicalDevice = logicalDevice;
     m_swapchainExtent = swapchainExtent;
+    m_setLayout = setLayout;
 
+    createPipeline(*renderPass, nullptr, vertSpecialization, fragSpecialization);
+};
+
+#ifdef VK_KHR_dynamic_rendering
+GraphicsPipeline::GraphicsPipeline(Device *logicalDevice, Extent2D *swapchainExtent, Format colorFormat,
+    DescriptorSetLayout *setLayout, const SpecializationInfo *vertSpecialization,
+    const SpecializationInfo *fragSpecialization) {
+    m_logicalDevice = logicalDevice;
+    m_swapchainExtent = swapchainExtent;
+    m_setLayout = setLayout;
+
+    // Without a render pass the attachment formats are given to the pipeline directly
+    PipelineRenderingCreateInfoKHR renderingInfo(0, 1, &colorFormat);
+
+    createPipeline(nullptr, &renderingInfo, vertSpecialization, fragSpecialization);
+};
+#endif // VK_KHR_dynamic_rendering
+
+GraphicsPipeline::~GraphicsPipeline() {
+    m_logicalDevice->destroyPipeline(m_pipeline);
+    m_logicalDevice->destroyPipelineLayout(m_pipelineLayout);
+};
+
+Pipeline *GraphicsPipeline::pipeline() {
+    return &m_pipeline;
+}
+
+PipelineLayout *GraphicsPipeline::layout() {
+    return &m_pipelineLayout;
+}
+
+void GraphicsPipeline::createPipeline(RenderPass renderPass, const void *renderingInfo,
+    const SpecializationInfo *vertSpecialization, const SpecializationInfo *fragSpecialization) {
     // Set up our shaders
     auto vertShaderCode = readFile(path("shaders/vert.spv"));
     auto fragShaderCode = readFile(path("shaders/frag.spv"));
@@ -14,8 +51,11 @@ GraphicsPipeline::GraphicsPipeline(Device *logicalDevice, Extent2D *swapchainExt
     ShaderModule vertShaderModule = createShaderModule(vertShaderCode);
     ShaderModule fragShaderModule = createShaderModule(fragShaderCode);
 
+    DebugUtils::setName(*m_logicalDevice, vertShaderModule, "vert.spv");
+    DebugUtils::setName(*m_logicalDevice, fragShaderModule, "frag.spv");
+
     // Set up all of the state infos
-    auto pipelineShaderInfo = createShaderStage(vertShaderModule, fragShaderModule);
+    auto pipelineShaderInfo = createShaderStage(vertShaderModule, fragShaderModule, vertSpecialization, fragSpecialization);
     PipelineVertexInputStateCreateInfo vertexInputInfo({}, 0, nullptr, 0, nullptr);
     PipelineInputAssemblyStateCreateInfo inputAssembly({}, PrimitiveTopology::eTriangleList, false);
     Viewport viewport(0.0f, 0.0f, (float) m_swapchainExtent->width,
@@ -55,40 +95,35 @@ GraphicsPipeline::GraphicsPipeline(Device *logicalDevice, Extent2D *swapchainExt
     colorBlending.blendConstants[2] = 0.0f;
     colorBlending.blendConstants[3] = 0.0f;
 
-    // Set up the pipeline layout
-    PipelineLayoutCreateInfo pipelineLayoutInfo; // Optional settings have been omitted
+    // Set up the pipeline layout: set 0 holds the sampled texture, no push constants
+    PipelineLayoutCreateInfo pipelineLayoutInfo({}, 1, m_setLayout);
 
     try {
-        m_logicalDevice->createPipelineLayout(&pipelineLayoutInfo, {}, &m_pipelineLayout, {});
+        m_logicalDevice->createPipelineLayout(&pipelineLayoutInfo, {}, &m_pipelineLayout);
     } catch (std::system_error e) {
         std::cerr << "Failed to create a pipeline layout." << std::endl;
         throw std::runtime_error(e.what());
     }
 
+    DebugUtils::setName(*m_logicalDevice, m_pipelineLayout, "triangle pipeline layout");
+
     GraphicsPipelineCreateInfo pipelineInfo({}, 2, pipelineShaderInfo.data(), &vertexInputInfo,
         &inputAssembly, nullptr, &viewportState, &rasterizer, &multisampling, nullptr, &colorBlending,
-        nullptr, m_pipelineLayout, *renderPass);
+        nullptr, m_pipelineLayout, renderPass);
+    pipelineInfo.pNext = renderingInfo;
 
     try {
-        m_logicalDevice->createGraphicsPipelines(nullptr, 1, &pipelineInfo, {}, &m_pipeline, {});
+        m_logicalDevice->createGraphicsPipelines(nullptr, 1, &pipelineInfo, {}, &m_pipeline);
     } catch (std::system_error e) {
         std::cerr << "Failed to create a graphics pipeline." << std::endl;
         throw std::runtime_error(e.what());
     }
 
+    DebugUtils::setName(*m_logicalDevice, m_pipeline, "triangle pipeline");
+
     // These are always at the end of this method.
     m_logicalDevice->destroyShaderModule(vertShaderModule);
     m_logicalDevice->destroyShaderModule(fragShaderModule);
-};
-
-
-GraphicsPipeline::~GraphicsPipeline() {
-    m_logicalDevice->destroyPipeline(m_pipeline);
-    m_logicalDevice->destroyPipelineLayout(m_pipelineLayout);
-};
-
-Pipeline *GraphicsPipeline::pipeline() {
-    return &m_pipeline;
 }
 
 std::vector<char> GraphicsPipeline::readFile(const path& filename) {
@@ -121,16 +156,17 @@ ShaderModule GraphicsPipeline::createShaderModule(const std::vector<char>& code)
     return shaderModule;
 }
 
-std::vector<PipelineShaderStageCreateInfo> GraphicsPipeline::createShaderStage(ShaderModule vertShaderModule, ShaderModule fragShaderModule) {
+std::vector<PipelineShaderStageCreateInfo> GraphicsPipeline::createShaderStage(ShaderModule vertShaderModule, ShaderModule fragShaderModule,
+    const SpecializationInfo *vertSpecialization, const SpecializationInfo *fragSpecialization) {
     std::vector<PipelineShaderStageCreateInfo> createInfos(2);
 
     PipelineShaderStageCreateInfo vertexShaderInfo({}, ShaderStageFlagBits::eVertex,
-        vertShaderModule, "main");
+        vertShaderModule, "main", vertSpecialization);
 
     createInfos[0] = vertexShaderInfo;
 
     PipelineShaderStageCreateInfo fragShaderInfo({}, ShaderStageFlagBits::eFragment,
-        fragShaderModule, "main");
+        fragShaderModule, "main", fragSpecialization);
 
     createInfos[1] = fragShaderInfo;
 
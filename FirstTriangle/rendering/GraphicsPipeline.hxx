@@ -6,20 +6,76 @@
 #include <filesystem>
 #include <vulkan/vulkan.hpp>
 
+#include "Specialization.hxx"
+
 using namespace std::filesystem;
 using namespace vk;
 
+/**
+ * Specialization constants exposed by shader.vert and shader.frag.
+ */
+namespace TriangleShader {
+    // Vertex stage
+    using Scale = SpecConstant<0, float>;
+
+    // Fragment stage
+    using Grayscale = SpecConstant<1, VkBool32>;
+    using PosterizeLevels = SpecConstant<2, int32_t>;
+
+    using VertexSpecialization = Specialization<Scale>;
+    using FragmentSpecialization = Specialization<Grayscale, PosterizeLevels>;
+}
+
 class GraphicsPipeline {
 public:
-    GraphicsPipeline(Device *logicalDevice, Extent2D *swapchainExtent, RenderPass *renderPass);
+    /**
+     * @param logicalDevice device to create the pipeline on
+     * @param swapchainExtent size of the viewport and scissor
+     * @param renderPass render pass the pipeline is used in
+     * @param setLayout layout of descriptor set 0, which holds the triangle's texture
+     * @param vertSpecialization specialization constants for the vertex shader, or nullptr for the defaults
+     * @param fragSpecialization specialization constants for the fragment shader, or nullptr for the defaults
+     */
+    GraphicsPipeline(Device *logicalDevice, Extent2D *swapchainExtent, RenderPass *renderPass,
+        DescriptorSetLayout *setLayout,
+        const SpecializationInfo *vertSpecialization = nullptr, const SpecializationInfo *fragSpecialization = nullptr);
+
+#ifdef VK_KHR_dynamic_rendering
+    /**
+     * Creates the pipeline for use with VK_KHR_dynamic_rendering, without a render pass.
+     *
+     * @param logicalDevice device to create the pipeline on
+     * @param swapchainExtent size of the viewport and scissor
+     * @param colorFormat format of the single color attachment rendered to
+     * @param setLayout layout of descriptor set 0, which holds the triangle's texture
+     * @param vertSpecialization specialization constants for the vertex shader, or nullptr for the defaults
+     * @param fragSpecialization specialization constants for the fragment shader, or nullptr for the defaults
+     */
+    GraphicsPipeline(Device *logicalDevice, Extent2D *swapchainExtent, Format colorFormat,
+        DescriptorSetLayout *setLayout,
+        const SpecializationInfo *vertSpecialization = nullptr, const SpecializationInfo *fragSpecialization = nullptr);
+#endif // VK_KHR_dynamic_rendering
     ~GraphicsPipeline();
     Pipeline *pipeline();
+    PipelineLayout *layout();
 private:
     Device *m_logicalDevice;
     Extent2D *m_swapchainExtent;
+    DescriptorSetLayout *m_setLayout;
     PipelineLayout m_pipelineLayout;
     Pipeline m_pipeline;
 
+    /**
+     * Builds the pipeline state and creates the layout and pipeline.
+     *
+     * @param renderPass render pass to create the pipeline for, or null with dynamic rendering
+     * @param renderingInfo chained into the create info; PipelineRenderingCreateInfoKHR with dynamic rendering
+     * @param vertSpecialization Vertex shader specialization constants, may be nullptr
+     * @param fragSpecialization Fragment shader specialization constants, may be nullptr
+     */
+    void createPipeline(RenderPass renderPass, const void *renderingInfo,
+        const SpecializationInfo *vertSpecialization, const SpecializationInfo *fragSpecialization);
+
     /**
      * Reads the binary data from the specified file into a vector.
      * 
@@ -41,8 +97,11 @@ private:
      * 
      * @param vertShaderModule Vertex shader module
      * @param fragShaderModule Fragment 
+     * @param vertSpecialization Vertex shader specialization constants, may be nullptr
+     * @param fragSpecialization Fragment shader specialization constants, may be nullptr
      */
-    std::vector<PipelineShaderStageCreateInfo> createShaderStage(ShaderModule vertShaderModule, ShaderModule fragShaderModule);
+    std::vector<PipelineShaderStageCreateInfo> createShaderStage(ShaderModule vertShaderModule, ShaderModule fragShaderModule,
+        const SpecializationInfo *vertSpecialization, const SpecializationInfo *fragSpecialization);
 
     PipelineMultisampleStateCreateInfo createMultiSampleStateInfo();
 };
@@ -0,0 +1,132 @@
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+#include "ImageDecoder.hxx"
+#include "MappedFile.hxx"
+
+namespace {
+    /**
+     * Reads the next unsigned integer from a PNM header, skipping whitespace and comments.
+     */
+    uint32_t readHeaderValue(const char *&cursor, const char *end) {
+        while (cursor < end) {
+            if (*cursor == '#') {
+                while (cursor < end && *cursor != '\n') {
+                    cursor++;
+                }
+            } else if (std::isspace(static_cast<unsigned char>(*cursor))) {
+                cursor++;
+            } else {
+                break;
+            }
+        }
+
+        if (cursor >= end || !std::isdigit(static_cast<unsigned char>(*cursor))) {
+            throw std::runtime_error("Malformed image header.");
+        }
+
+        uint64_t value = 0;
+        while (cursor < end && std::isdigit(static_cast<unsigned char>(*cursor)) && value <= UINT32_MAX) {
+            value = value * 10 + (*cursor - '0');
+            cursor++;
+        }
+
+        if (value > UINT32_MAX) {
+            throw std::runtime_error("Malformed image header.");
+        }
+
+        return static_cast<uint32_t>(value);
+    }
+}
+
+ImageData ImageDecoder::decode(const std::filesystem::path& filename) {
+    MappedFile file(filename);
+
+    const char *cursor = file.data();
+    const char *end = file.data() + file.size();
+
+    if (file.size() < 2 || cursor[0] != 'P' || (cursor[1] != '6' && cursor[1] != '5')) {
+        throw std::runtime_error("Unsupported image format: " + filename.string());
+    }
+
+    size_t channels = cursor[1] == '6' ? 3 : 1;
+    cursor += 2;
+
+    ImageData image;
+    image.width = readHeaderValue(cursor, end);
+    image.height = readHeaderValue(cursor, end);
+    uint32_t maxValue = readHeaderValue(cursor, end);
+
+    if (image.width == 0 || image.height == 0 || maxValue == 0 || maxValue > 255) {
+        throw std::runtime_error("Unsupported image dimensions or depth: " + filename.string());
+    }
+
+    // Exactly one whitespace character separates the header from the pixel data
+    cursor++;
+
+    size_t pixelCount = static_cast<size_t>(image.width) * image.height;
+    if (cursor > end || static_cast<size_t>(end - cursor) < pixelCount * channels) {
+        throw std::runtime_error("Truncated image: " + filename.string());
+    }
+
+    const uint8_t *source = reinterpret_cast<const uint8_t*>(cursor);
+    image.pixels.resize(pixelCount * 4);
+
+    for (size_t i = 0; i < pixelCount; i++) {
+        for (size_t c = 0; c < 3; c++) {
+            uint32_t value = source[i * channels + (channels == 3 ? c : 0)];
+            image.pixels[i * 4 + c] = static_cast<uint8_t>(value * 255 / maxValue);
+        }
+
+        image.pixels[i * 4 + 3] = 255;
+    }
+
+    return image;
+}
+
+ImageData ImageDecoder::downsample(const ImageData& image, uint32_t levels) {
+    ImageData current = image;
+
+    for (uint32_t level = 0; level < levels && (current.width > 1 || current.height > 1); level++) {
+        ImageData next;
+        next.width = std::max(1u, current.width / 2);
+        next.height = std::max(1u, current.height / 2);
+        next.pixels.resize(static_cast<size_t>(next.width) * next.height * 4);
+
+        for (uint32_t y = 0; y < next.height; y++) {
+            uint32_t y0 = std::min(y * 2, current.height - 1);
+            uint32_t y1 = std::min(y * 2 + 1, current.height - 1);
+
+            for (uint32_t x = 0; x < next.width; x++) {
+                uint32_t x0 = std::min(x * 2, current.width - 1);
+                uint32_t x1 = std::min(x * 2 + 1, current.width - 1);
+
+                for (uint32_t c = 0; c < 4; c++) {
+                    uint32_t sum = current.pixels[(static_cast<size_t>(y0) * current.width + x0) * 4 + c] +
+                        current.pixels[(static_cast<size_t>(y0) * current.width + x1) * 4 + c] +
+                        current.pixels[(static_cast<size_t>(y1) * current.width + x0) * 4 + c] +
+                        current.pixels[(static_cast<size_t>(y1) * current.width + x1) * 4 + c];
+
+                    next.pixels[(static_cast<size_t>(y) * next.width + x) * 4 + c] = static_cast<uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        current = std::move(next);
+    }
+
+    return current;
+}
+
+uint32_t ImageDecoder::mipLevelCount(uint32_t width, uint32_t height) {
+    uint32_t levels = 1;
+    uint32_t size = std::max(width, height);
+
+    while (size > 1) {
+        size /= 2;
+        levels++;
+    }
+
+    return levels;
+}
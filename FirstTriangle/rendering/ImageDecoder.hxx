@@ -0,0 +1,42 @@
+#ifndef IMAGE_DECODER_HXX
+#define IMAGE_DECODER_HXX
+
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+/**
+ * Tightly packed 8-bit RGBA pixels.
+ */
+struct ImageData {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::vector<uint8_t> pixels;
+};
+
+class ImageDecoder {
+public:
+    /**
+     * Decodes a binary PPM (P6) or PGM (P5) image with 8-bit channels into RGBA.
+     *
+     * @param filename path to the image
+     * @return the decoded pixels
+     */
+    static ImageData decode(const std::filesystem::path& filename);
+
+    /**
+     * Halves the image `levels` times with a box filter, as a mip chain would.
+     *
+     * @param image source pixels
+     * @param levels number of times to halve the image
+     * @return the downsampled pixels
+     */
+    static ImageData downsample(const ImageData& image, uint32_t levels);
+
+    /**
+     * The number of levels in a full mip chain for the given size.
+     */
+    static uint32_t mipLevelCount(uint32_t width, uint32_t height);
+};
+
+#endif // IMAGE_DECODER_HXX
@@ -0,0 +1,58 @@
+extern "C" {
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+}
+
+#include <stdexcept>
+
+#include "MappedFile.hxx"
+
+MappedFile::MappedFile(const std::filesystem::path& filename) {
+    m_fd = open(filename.c_str(), O_RDONLY);
+
+    if (m_fd < 0) {
+        throw std::runtime_error("Failed to open file: " + filename.string());
+    }
+
+    struct stat fileStat;
+    if (fstat(m_fd, &fileStat) != 0) {
+        close(m_fd);
+        throw std::runtime_error("Failed to stat file: " + filename.string());
+    }
+
+    m_size = static_cast<size_t>(fileStat.st_size);
+
+    // mmap rejects empty mappings; an empty file simply has no data
+    if (m_size == 0) {
+        return;
+    }
+
+    m_data = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fd, 0);
+
+    if (m_data == MAP_FAILED) {
+        m_data = nullptr;
+        close(m_fd);
+        throw std::runtime_error("Failed to map file: " + filename.string());
+    }
+
+    // The whole file is about to be read, so start paging it in now
+    madvise(m_data, m_size, MADV_WILLNEED);
+}
+
+MappedFile::~MappedFile() {
+    if (m_data != nullptr) {
+        munmap(m_data, m_size);
+    }
+
+    close(m_fd);
+}
+
+const char *MappedFile::data() const {
+    return static_cast<const char*>(m_data);
+}
+
+size_t MappedFile::size() const {
+    return m_size;
+}
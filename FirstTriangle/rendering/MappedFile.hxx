@@ -0,0 +1,26 @@
+#ifndef MAPPED_FILE_HXX
+#define MAPPED_FILE_HXX
+
+#include <cstddef>
+#include <filesystem>
+
+/**
+ * A read-only memory mapping of a whole file.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::filesystem::path& filename);
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char *data() const;
+    size_t size() const;
+private:
+    int m_fd = -1;
+    void *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+#endif // MAPPED_FILE_HXX
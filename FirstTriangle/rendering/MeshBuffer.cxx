@@ -0,0 +1,137 @@
+#include <iostream>
+#include <cstring>
+
+#include "MeshBuffer.hxx"
+
+MeshBuffer::MeshBuffer(vk::PhysicalDevice physicalDevice, vk::Device *logicalDevice, QueueSubmitter *transfer,
+    uint32_t graphicsFamily, const MeshFile& mesh) {
+    m_logicalDevice = logicalDevice;
+    m_transfer = transfer;
+    m_indexCount = mesh.indexCount();
+
+    if (mesh.vertexCount() == 0 || mesh.indexCount() == 0) {
+        throw std::runtime_error("Mesh has no geometry to upload.");
+    }
+
+    try {
+        upload(physicalDevice, graphicsFamily, mesh);
+    } catch (...) {
+        // The destructor does not run for a constructor that throws. Nothing was submitted if we got
+        // here, since submitting is the last step that can throw.
+        if (m_uploadCommands) {
+            m_logicalDevice->freeCommandBuffers(*m_transfer->commandPool(), m_uploadCommands);
+        }
+
+        delete m_stagingBuffer;
+        delete m_indexBuffer;
+        delete m_vertexBuffer;
+        throw;
+    }
+}
+
+MeshBuffer::~MeshBuffer() {
+    // The copy may still be reading from the staging buffer
+    m_transfer->wait(m_readyValue);
+    releaseStaging();
+
+    delete m_indexBuffer;
+    delete m_vertexBuffer;
+}
+
+vk::Buffer *MeshBuffer::vertexBuffer() {
+    return m_vertexBuffer->buffer();
+}
+
+vk::Buffer *MeshBuffer::indexBuffer() {
+    return m_indexBuffer->buffer();
+}
+
+uint32_t MeshBuffer::indexCount() {
+    return m_indexCount;
+}
+
+bool MeshBuffer::isReady() {
+    if (m_transfer->completed() < m_readyValue) {
+        return false;
+    }
+
+    releaseStaging();
+
+    return true;
+}
+
+void MeshBuffer::upload(vk::PhysicalDevice physicalDevice, uint32_t graphicsFamily, const MeshFile& mesh) {
+    std::vector<uint32_t> families = {graphicsFamily, m_transfer->familyIndex()};
+
+    // Prefer memory the CPU can write directly (integrated GPUs, resizable BAR, software drivers)
+    std::vector<vk::MemoryPropertyFlags> preferred = {
+        vk::MemoryPropertyFlagBits::eDeviceLocal | vk::MemoryPropertyFlagBits::eHostVisible,
+        vk::MemoryPropertyFlagBits::eDeviceLocal
+    };
+
+    m_vertexBuffer = new Buffer(physicalDevice, m_logicalDevice, mesh.vertexBytes(),
+        vk::BufferUsageFlagBits::eVertexBuffer | vk::BufferUsageFlagBits::eTransferDst, preferred, families);
+
+    m_indexBuffer = new Buffer(physicalDevice, m_logicalDevice, mesh.indexBytes(),
+        vk::BufferUsageFlagBits::eIndexBuffer | vk::BufferUsageFlagBits::eTransferDst, preferred, families);
+
+    bool directUpload = (m_vertexBuffer->memoryProperties() & vk::MemoryPropertyFlagBits::eHostVisible) &&
+        (m_indexBuffer->memoryProperties() & vk::MemoryPropertyFlagBits::eHostVisible);
+
+    if (directUpload) {
+        std::memcpy(m_vertexBuffer->map(), mesh.vertices(), mesh.vertexBytes());
+        m_vertexBuffer->flush();
+        m_vertexBuffer->unmap();
+
+        std::memcpy(m_indexBuffer->map(), mesh.indices(), mesh.indexBytes());
+        m_indexBuffer->flush();
+        m_indexBuffer->unmap();
+
+        return;
+    }
+
+    // Both arrays share one staging buffer, indices after vertices
+    m_stagingBuffer = new Buffer(physicalDevice, m_logicalDevice, mesh.vertexBytes() + mesh.indexBytes(),
+        vk::BufferUsageFlagBits::eTransferSrc,
+        {vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+         vk::MemoryPropertyFlagBits::eHostVisible});
+
+    char *staging = static_cast<char*>(m_stagingBuffer->map());
+    std::memcpy(staging, mesh.vertices(), mesh.vertexBytes());
+    std::memcpy(staging + mesh.vertexBytes(), mesh.indices(), mesh.indexBytes());
+    m_stagingBuffer->flush();
+    m_stagingBuffer->unmap();
+
+    vk::CommandBufferAllocateInfo allocateInfo(*m_transfer->commandPool(), vk::CommandBufferLevel::ePrimary, 1);
+
+    try {
+        m_uploadCommands = m_logicalDevice->allocateCommandBuffers(allocateInfo)[0];
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to allocate mesh upload command buffer." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+
+    vk::CommandBufferBeginInfo beginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+    m_uploadCommands.begin(beginInfo);
+
+    vk::BufferCopy vertexCopy(0, 0, mesh.vertexBytes());
+    m_uploadCommands.copyBuffer(*m_stagingBuffer->buffer(), *m_vertexBuffer->buffer(), vertexCopy);
+
+    vk::BufferCopy indexCopy(mesh.vertexBytes(), 0, mesh.indexBytes());
+    m_uploadCommands.copyBuffer(*m_stagingBuffer->buffer(), *m_indexBuffer->buffer(), indexCopy);
+
+    m_uploadCommands.end();
+
+    m_readyValue = m_transfer->submit({m_uploadCommands});
+}
+
+void MeshBuffer::releaseStaging() {
+    if (m_stagingBuffer == nullptr) {
+        return;
+    }
+
+    m_logicalDevice->freeCommandBuffers(*m_transfer->commandPool(), m_uploadCommands);
+
+    delete m_stagingBuffer;
+    m_stagingBuffer = nullptr;
+}
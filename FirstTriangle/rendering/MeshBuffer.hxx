@@ -0,0 +1,59 @@
+#ifndef MESH_BUFFER_HXX
+#define MESH_BUFFER_HXX
+
+#include <vulkan/vulkan.hpp>
+
+#include "Buffer.hxx"
+#include "MeshFile.hxx"
+#include "QueueSubmitter.hxx"
+
+class MeshBuffer {
+public:
+    /**
+     * Creates vertex and index buffers for a mapped mesh and uploads it.
+     *
+     * If the device has host-visible device-local memory the data is copied straight from the file
+     * mapping into the buffers. Otherwise it goes through a staging buffer and a copy on the transfer queue.
+     *
+     * @param physicalDevice device used to look up memory types
+     * @param logicalDevice device that owns the buffers
+     * @param transfer submitter for the transfer queue
+     * @param graphicsFamily queue family the buffers are drawn from
+     * @param mesh mapped mesh file to upload
+     */
+    MeshBuffer(vk::PhysicalDevice physicalDevice, vk::Device *logicalDevice, QueueSubmitter *transfer,
+        uint32_t graphicsFamily, const MeshFile& mesh);
+    ~MeshBuffer();
+
+    vk::Buffer *vertexBuffer();
+    vk::Buffer *indexBuffer();
+    uint32_t indexCount();
+
+    /**
+     * Checks whether the upload has finished, releasing the staging resources once it has.
+     *
+     * Draws submitted through VulkanWindow already wait on the transfer queue, so this is only needed
+     * to free staging memory early.
+     */
+    bool isReady();
+private:
+    vk::Device *m_logicalDevice;
+    QueueSubmitter *m_transfer;
+    Buffer *m_vertexBuffer = nullptr;
+    Buffer *m_indexBuffer = nullptr;
+    uint32_t m_indexCount;
+
+    // Only used when the buffers are not host-visible
+    Buffer *m_stagingBuffer = nullptr;
+    vk::CommandBuffer m_uploadCommands;
+    uint64_t m_readyValue = 0;
+
+    /**
+     * Creates the buffers and starts the upload. On failure the constructor frees whatever was created.
+     */
+    void upload(vk::PhysicalDevice physicalDevice, uint32_t graphicsFamily, const MeshFile& mesh);
+
+    void releaseStaging();
+};
+
+#endif // MESH_BUFFER_HXX
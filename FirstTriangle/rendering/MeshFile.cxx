@@ -0,0 +1,88 @@
+#include <fstream>
+#include <cstring>
+#include <stdexcept>
+
+#include "MeshFile.hxx"
+
+static uint64_t alignUp(uint64_t value, uint64_t alignment) {
+    return (value + alignment - 1) & ~(alignment - 1);
+}
+
+MeshFile::MeshFile(const std::filesystem::path& filename) : m_file(filename) {
+    if (m_file.size() < sizeof(MeshFileHeader)) {
+        throw std::runtime_error("Mesh file is too small: " + filename.string());
+    }
+
+    m_header = reinterpret_cast<const MeshFileHeader*>(m_file.data());
+
+    if (std::memcmp(m_header->magic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC)) != 0 ||
+        m_header->version != MESH_FILE_VERSION || m_header->vertexStride != sizeof(Vertex)) {
+        throw std::runtime_error("Unsupported mesh file: " + filename.string());
+    }
+
+    // The arrays are read in place, so their offsets must keep them aligned
+    if (m_header->vertexOffset % MESH_FILE_ALIGNMENT != 0 || m_header->indexOffset % MESH_FILE_ALIGNMENT != 0) {
+        throw std::runtime_error("Misaligned mesh file: " + filename.string());
+    }
+
+    // Written as offset/size comparisons so that corrupt headers cannot wrap around
+    if (m_header->vertexOffset > m_file.size() || vertexBytes() > m_file.size() - m_header->vertexOffset ||
+        m_header->indexOffset > m_file.size() || indexBytes() > m_file.size() - m_header->indexOffset) {
+        throw std::runtime_error("Truncated mesh file: " + filename.string());
+    }
+}
+
+uint32_t MeshFile::vertexCount() const {
+    return m_header->vertexCount;
+}
+
+uint32_t MeshFile::indexCount() const {
+    return m_header->indexCount;
+}
+
+const Vertex *MeshFile::vertices() const {
+    return reinterpret_cast<const Vertex*>(m_file.data() + m_header->vertexOffset);
+}
+
+const uint32_t *MeshFile::indices() const {
+    return reinterpret_cast<const uint32_t*>(m_file.data() + m_header->indexOffset);
+}
+
+size_t MeshFile::vertexBytes() const {
+    return static_cast<size_t>(m_header->vertexCount) * sizeof(Vertex);
+}
+
+size_t MeshFile::indexBytes() const {
+    return static_cast<size_t>(m_header->indexCount) * sizeof(uint32_t);
+}
+
+void MeshFile::write(const std::filesystem::path& filename, const MeshData& mesh) {
+    MeshFileHeader header = {};
+    std::memcpy(header.magic, MESH_FILE_MAGIC, sizeof(MESH_FILE_MAGIC));
+    header.version = MESH_FILE_VERSION;
+    header.vertexStride = sizeof(Vertex);
+    header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+    header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+
+    uint64_t vertexBytes = mesh.vertices.size() * sizeof(Vertex);
+    header.vertexOffset = alignUp(sizeof(MeshFileHeader), MESH_FILE_ALIGNMENT);
+    header.indexOffset = alignUp(header.vertexOffset + vertexBytes, MESH_FILE_ALIGNMENT);
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open file for writing: " + filename.string());
+    }
+
+    const char padding[MESH_FILE_ALIGNMENT] = {};
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding, header.vertexOffset - sizeof(header));
+    file.write(reinterpret_cast<const char*>(mesh.vertices.data()), vertexBytes);
+    file.write(padding, header.indexOffset - header.vertexOffset - vertexBytes);
+    file.write(reinterpret_cast<const char*>(mesh.indices.data()), mesh.indices.size() * sizeof(uint32_t));
+
+    if (!file.good()) {
+        throw std::runtime_error("Failed to write mesh file: " + filename.string());
+    }
+}
@@ -0,0 +1,75 @@
+#ifndef MESH_FILE_HXX
+#define MESH_FILE_HXX
+
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+
+#include "MappedFile.hxx"
+
+struct Vertex {
+    float position[3];
+    float normal[3];
+    float uv[2];
+};
+
+/**
+ * Geometry in the layout it is drawn with: 32-bit indices into an interleaved vertex array.
+ */
+struct MeshData {
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+};
+
+/**
+ * Header of the binary mesh format.
+ *
+ * The vertex and index arrays follow at the given offsets, each aligned to MESH_FILE_ALIGNMENT,
+ * so that they can be copied to the GPU straight out of the mapping.
+ */
+struct MeshFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t vertexStride;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t reserved;
+    uint64_t vertexOffset;
+    uint64_t indexOffset;
+};
+
+static const char MESH_FILE_MAGIC[4] = {'V', 'P', 'M', 'S'};
+static const uint32_t MESH_FILE_VERSION = 1;
+static const uint64_t MESH_FILE_ALIGNMENT = 16;
+
+class MeshFile {
+public:
+    /**
+     * Maps a binary mesh file and validates its header.
+     *
+     * @param filename path to a file written by MeshFile::write()
+     */
+    explicit MeshFile(const std::filesystem::path& filename);
+
+    uint32_t vertexCount() const;
+    uint32_t indexCount() const;
+
+    const Vertex *vertices() const;
+    const uint32_t *indices() const;
+
+    size_t vertexBytes() const;
+    size_t indexBytes() const;
+
+    /**
+     * Writes mesh data in the binary mesh format.
+     *
+     * @param filename destination path
+     * @param mesh geometry to write
+     */
+    static void write(const std::filesystem::path& filename, const MeshData& mesh);
+private:
+    MappedFile m_file;
+    const MeshFileHeader *m_header;
+};
+
+#endif // MESH_FILE_HXX
@@ -0,0 +1,319 @@
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <unordered_map>
+#include <stdexcept>
+#include <cstring>
+
+#include "MeshImporter.hxx"
+#include "MeshOptimizer.hxx"
+
+namespace {
+    // Smallest amount of text worth handing to a worker
+    const size_t MIN_CHUNK_BYTES = 64 * 1024;
+    // Chunks per worker, so that uneven chunks still balance out
+    const size_t CHUNKS_PER_WORKER = 4;
+
+    const int64_t NO_INDEX = INT64_MIN;
+
+    enum Attribute {
+        POSITION = 0,
+        UV = 1,
+        NORMAL = 2
+    };
+
+    /**
+     * One corner of a triangle as written in the file.
+     *
+     * Negative (relative) OBJ indices can only be resolved once the element counts of all previous
+     * chunks are known, so they are stored relative to the start of their chunk and flagged in `local`.
+     */
+    struct Corner {
+        int64_t index[3];
+        uint8_t local;
+    };
+
+    struct Chunk {
+        std::vector<float> positions;
+        std::vector<float> uvs;
+        std::vector<float> normals;
+        std::vector<Corner> corners;
+
+        // Scratch space for the face being parsed, reused so n-gons of any size do not allocate per face
+        std::vector<Corner> polygon;
+    };
+
+    struct VertexKey {
+        uint64_t position;
+        uint64_t uv;
+        uint64_t normal;
+
+        bool operator==(const VertexKey& other) const {
+            return position == other.position && uv == other.uv && normal == other.normal;
+        }
+    };
+
+    struct VertexKeyHash {
+        size_t operator()(const VertexKey& key) const {
+            uint64_t hash = key.position * 0x9E3779B97F4A7C15ull;
+            hash ^= key.uv + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            hash ^= key.normal + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    const char *skipSpaces(const char *cursor, const char *end) {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t')) {
+            cursor++;
+        }
+
+        return cursor;
+    }
+
+    /**
+     * Parses up to `count` whitespace-separated floats and appends them, padding missing values with 0.
+     */
+    void parseFloats(const char *cursor, const char *end, size_t count, std::vector<float>& out) {
+        for (size_t i = 0; i < count; i++) {
+            cursor = skipSpaces(cursor, end);
+
+            float value = 0.0f;
+            auto result = std::from_chars(cursor, end, value);
+
+            if (result.ec == std::errc()) {
+                cursor = result.ptr;
+            }
+
+            out.push_back(value);
+        }
+    }
+
+    void parseFace(const char *cursor, const char *end, Chunk& chunk) {
+        size_t counts[3] = {
+            chunk.positions.size() / 3,
+            chunk.uvs.size() / 2,
+            chunk.normals.size() / 3
+        };
+
+        std::vector<Corner>& polygon = chunk.polygon;
+        polygon.clear();
+
+        while (true) {
+            cursor = skipSpaces(cursor, end);
+
+            if (cursor >= end) {
+                break;
+            }
+
+            Corner corner = {{NO_INDEX, NO_INDEX, NO_INDEX}, 0};
+
+            // Tokens look like p, p/t, p//n or p/t/n
+            for (int attribute = POSITION; attribute <= NORMAL && cursor < end; attribute++) {
+                int64_t raw = 0;
+                auto result = std::from_chars(cursor, end, raw);
+
+                if (result.ec == std::errc() && raw != 0) {
+                    cursor = result.ptr;
+
+                    if (raw > 0) {
+                        corner.index[attribute] = raw - 1;
+                    } else {
+                        corner.index[attribute] = static_cast<int64_t>(counts[attribute]) + raw;
+                        corner.local |= 1 << attribute;
+                    }
+                }
+
+                if (cursor >= end || *cursor != '/') {
+                    break;
+                }
+
+                cursor++;
+            }
+
+            // Skip whatever is left of a malformed token
+            while (cursor < end && *cursor != ' ' && *cursor != '\t') {
+                cursor++;
+            }
+
+            if (corner.index[POSITION] != NO_INDEX) {
+                polygon.push_back(corner);
+            }
+        }
+
+        // Triangulate as a fan around the first corner
+        for (size_t i = 1; i + 1 < polygon.size(); i++) {
+            chunk.corners.push_back(polygon[0]);
+            chunk.corners.push_back(polygon[i]);
+            chunk.corners.push_back(polygon[i + 1]);
+        }
+    }
+
+    Chunk parseChunk(const char *begin, const char *end) {
+        Chunk chunk;
+
+        const char *line = begin;
+        while (line < end) {
+            const char *lineEnd = static_cast<const char*>(std::memchr(line, '\n', end - line));
+            if (lineEnd == nullptr) {
+                lineEnd = end;
+            }
+
+            const char *contentEnd = lineEnd;
+            if (contentEnd > line && contentEnd[-1] == '\r') {
+                contentEnd--;
+            }
+
+            const char *cursor = skipSpaces(line, contentEnd);
+            size_t length = contentEnd - cursor;
+
+            if (length > 2 && cursor[0] == 'v' && cursor[1] == ' ') {
+                parseFloats(cursor + 2, contentEnd, 3, chunk.positions);
+            } else if (length > 3 && cursor[0] == 'v' && cursor[1] == 't' && cursor[2] == ' ') {
+                parseFloats(cursor + 3, contentEnd, 2, chunk.uvs);
+            } else if (length > 3 && cursor[0] == 'v' && cursor[1] == 'n' && cursor[2] == ' ') {
+                parseFloats(cursor + 3, contentEnd, 3, chunk.normals);
+            } else if (length > 2 && cursor[0] == 'f' && cursor[1] == ' ') {
+                parseFace(cursor + 2, contentEnd, chunk);
+            }
+
+            line = lineEnd + 1;
+        }
+
+        return chunk;
+    }
+
+    /**
+     * Splits the text into roughly equal chunks that each end on a line break.
+     */
+    std::vector<std::pair<const char*, const char*>> splitLines(const char *data, size_t size, size_t chunkCount) {
+        std::vector<std::pair<const char*, const char*>> chunks;
+
+        const char *end = data + size;
+        const char *begin = data;
+
+        for (size_t i = 1; i <= chunkCount && begin < end; i++) {
+            const char *split = data + (size * i) / chunkCount;
+
+            if (split < begin) {
+                continue;
+            }
+
+            const char *lineBreak = static_cast<const char*>(std::memchr(split, '\n', end - split));
+            const char *chunkEnd = lineBreak == nullptr ? end : lineBreak + 1;
+
+            chunks.emplace_back(begin, chunkEnd);
+            begin = chunkEnd;
+        }
+
+        if (begin < end) {
+            chunks.emplace_back(begin, end);
+        }
+
+        return chunks;
+    }
+}
+
+MeshData MeshImporter::importObj(const std::filesystem::path& filename, ThreadPool& pool) {
+    MappedFile file(filename);
+
+    size_t chunkCount = std::max<size_t>(1, std::min(pool.size() * CHUNKS_PER_WORKER, file.size() / MIN_CHUNK_BYTES));
+
+    std::vector<std::future<Chunk>> pending;
+    for (const auto& range : splitLines(file.data(), file.size(), chunkCount)) {
+        pending.push_back(pool.enqueue([range]() { return parseChunk(range.first, range.second); }));
+    }
+
+    std::vector<Chunk> chunks;
+    for (auto& future : pending) {
+        chunks.push_back(future.get());
+    }
+
+    // Concatenate the attribute arrays, remembering where each chunk starts
+    std::vector<float> positions;
+    std::vector<float> uvs;
+    std::vector<float> normals;
+    std::vector<std::array<int64_t, 3>> chunkBases;
+    size_t cornerCount = 0;
+
+    for (const auto& chunk : chunks) {
+        chunkBases.push_back({
+            static_cast<int64_t>(positions.size() / 3),
+            static_cast<int64_t>(uvs.size() / 2),
+            static_cast<int64_t>(normals.size() / 3)
+        });
+
+        positions.insert(positions.end(), chunk.positions.begin(), chunk.positions.end());
+        uvs.insert(uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+        normals.insert(normals.end(), chunk.normals.begin(), chunk.normals.end());
+        cornerCount += chunk.corners.size();
+    }
+
+    const int64_t totals[3] = {
+        static_cast<int64_t>(positions.size() / 3),
+        static_cast<int64_t>(uvs.size() / 2),
+        static_cast<int64_t>(normals.size() / 3)
+    };
+
+    // Merge identical corners into shared vertices
+    MeshData mesh;
+    mesh.indices.reserve(cornerCount);
+
+    std::unordered_map<VertexKey, uint32_t, VertexKeyHash> vertexLookup;
+    vertexLookup.reserve(cornerCount / 2);
+
+    for (size_t c = 0; c < chunks.size(); c++) {
+        for (const auto& corner : chunks[c].corners) {
+            int64_t resolved[3];
+
+            for (int attribute = POSITION; attribute <= NORMAL; attribute++) {
+                int64_t index = corner.index[attribute];
+
+                if (index != NO_INDEX && (corner.local & (1 << attribute))) {
+                    index += chunkBases[c][attribute];
+                }
+
+                if (index != NO_INDEX && (index < 0 || index >= totals[attribute])) {
+                    throw std::runtime_error("Out of range index in OBJ file: " + filename.string());
+                }
+
+                resolved[attribute] = index;
+            }
+
+            VertexKey key = {
+                static_cast<uint64_t>(resolved[POSITION]),
+                static_cast<uint64_t>(resolved[UV]),
+                static_cast<uint64_t>(resolved[NORMAL])
+            };
+
+            auto inserted = vertexLookup.emplace(key, static_cast<uint32_t>(mesh.vertices.size()));
+
+            if (inserted.second) {
+                Vertex vertex = {};
+                std::memcpy(vertex.position, &positions[resolved[POSITION] * 3], sizeof(vertex.position));
+
+                if (resolved[NORMAL] != NO_INDEX) {
+                    std::memcpy(vertex.normal, &normals[resolved[NORMAL] * 3], sizeof(vertex.normal));
+                }
+
+                if (resolved[UV] != NO_INDEX) {
+                    std::memcpy(vertex.uv, &uvs[resolved[UV] * 2], sizeof(vertex.uv));
+                }
+
+                mesh.vertices.push_back(vertex);
+            }
+
+            mesh.indices.push_back(inserted.first->second);
+        }
+    }
+
+    return mesh;
+}
+
+void MeshImporter::convert(const std::filesystem::path& source, const std::filesystem::path& destination,
+    ThreadPool& pool) {
+    MeshData mesh = importObj(source, pool);
+
+    MeshOptimizer::optimize(mesh);
+
+    MeshFile::write(destination, mesh);
+}
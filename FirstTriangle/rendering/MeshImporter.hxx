@@ -0,0 +1,33 @@
+#ifndef MESH_IMPORTER_HXX
+#define MESH_IMPORTER_HXX
+
+#include <filesystem>
+
+#include "MeshFile.hxx"
+#include "ThreadPool.hxx"
+
+class MeshImporter {
+public:
+    /**
+     * Parses a Wavefront OBJ file, splitting the text into chunks that are parsed on the pool.
+     *
+     * Polygons are triangulated as fans and identical position/uv/normal combinations are merged.
+     *
+     * @param filename path to the .obj file
+     * @param pool worker pool to parse on
+     * @return the triangulated, indexed mesh
+     */
+    static MeshData importObj(const std::filesystem::path& filename, ThreadPool& pool);
+
+    /**
+     * Imports a source mesh, optimizes it and writes it in the binary mesh format.
+     *
+     * @param source path to the .obj file
+     * @param destination path of the binary mesh file to write
+     * @param pool worker pool to parse on
+     */
+    static void convert(const std::filesystem::path& source, const std::filesystem::path& destination,
+        ThreadPool& pool);
+};
+
+#endif // MESH_IMPORTER_HXX
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+#include "MeshOptimizer.hxx"
+
+// Upper bound on cluster size so that large, well-connected meshes still have clusters to sort
+static const size_t MAX_CLUSTER_TRIANGLES = 128;
+
+void MeshOptimizer::optimize(MeshData& mesh, uint32_t cacheSize) {
+    std::vector<size_t> clusters;
+
+    mesh.indices = optimizeVertexCache(mesh.indices, mesh.vertices.size(), cacheSize, &clusters);
+    optimizeOverdraw(mesh.indices, mesh.vertices, clusters);
+    optimizeVertexFetch(mesh);
+}
+
+std::vector<uint32_t> MeshOptimizer::optimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+    uint32_t cacheSize, std::vector<size_t> *clusters) {
+    size_t triangleCount = indices.size() / 3;
+
+    std::vector<uint32_t> output;
+    output.reserve(triangleCount * 3);
+
+    if (triangleCount == 0) {
+        return output;
+    }
+
+    // Vertex -> triangle adjacency, stored as offsets into a flat array
+    std::vector<uint32_t> liveTriangles(vertexCount, 0);
+    for (size_t i = 0; i < triangleCount * 3; i++) {
+        liveTriangles[indices[i]]++;
+    }
+
+    std::vector<uint32_t> offsets(vertexCount + 1, 0);
+    std::partial_sum(liveTriangles.begin(), liveTriangles.end(), offsets.begin() + 1);
+
+    std::vector<uint32_t> adjacency(triangleCount * 3);
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t t = 0; t < triangleCount; t++) {
+        for (size_t k = 0; k < 3; k++) {
+            adjacency[fill[indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+        }
+    }
+
+    std::vector<uint32_t> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<uint32_t> deadEnds;
+    std::vector<uint32_t> candidates;
+
+    uint32_t timestamp = cacheSize + 1;
+    size_t cursor = 0;
+    bool clusterBoundary = true;
+
+    int64_t fanVertex = 0;
+    while (fanVertex >= 0) {
+        candidates.clear();
+
+        // Emit every remaining triangle around the fanning vertex
+        for (uint32_t a = offsets[fanVertex]; a < offsets[fanVertex + 1]; a++) {
+            uint32_t t = adjacency[a];
+
+            if (emitted[t]) {
+                continue;
+            }
+
+            if (clusters != nullptr) {
+                size_t emittedTriangles = output.size() / 3;
+
+                if (clusterBoundary || emittedTriangles - clusters->back() >= MAX_CLUSTER_TRIANGLES) {
+                    clusters->push_back(emittedTriangles);
+                    clusterBoundary = false;
+                }
+            }
+
+            for (size_t k = 0; k < 3; k++) {
+                uint32_t v = indices[t * 3 + k];
+
+                output.push_back(v);
+                deadEnds.push_back(v);
+                candidates.push_back(v);
+                liveTriangles[v]--;
+
+                if (timestamp - cacheTime[v] > cacheSize) {
+                    cacheTime[v] = timestamp;
+                    timestamp++;
+                }
+            }
+
+            emitted[t] = true;
+        }
+
+        // Pick the candidate that will still be in the cache once its fan is emitted, preferring the oldest
+        int64_t nextVertex = -1;
+        int64_t bestPriority = -1;
+
+        for (uint32_t v : candidates) {
+            if (liveTriangles[v] == 0) {
+                continue;
+            }
+
+            int64_t priority = 0;
+            if (timestamp - cacheTime[v] + 2 * liveTriangles[v] <= cacheSize) {
+                priority = timestamp - cacheTime[v];
+            }
+
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                nextVertex = v;
+            }
+        }
+
+        if (nextVertex == -1) {
+            // Dead end: fall back to recently used vertices, then to the next vertex in input order
+            clusterBoundary = true;
+
+            while (!deadEnds.empty() && nextVertex == -1) {
+                uint32_t v = deadEnds.back();
+                deadEnds.pop_back();
+
+                if (liveTriangles[v] > 0) {
+                    nextVertex = v;
+                }
+            }
+
+            while (cursor < vertexCount && nextVertex == -1) {
+                if (liveTriangles[cursor] > 0) {
+                    nextVertex = static_cast<int64_t>(cursor);
+                }
+
+                cursor++;
+            }
+        }
+
+        fanVertex = nextVertex;
+    }
+
+    return output;
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+    const std::vector<size_t>& clusters) {
+    size_t triangleCount = indices.size() / 3;
+
+    if (clusters.size() < 2) {
+        return;
+    }
+
+    struct ClusterInfo {
+        size_t begin;
+        size_t end;
+        float sortKey;
+    };
+
+    std::vector<ClusterInfo> infos;
+    std::vector<float> centroids(clusters.size() * 3, 0.0f);
+    std::vector<float> normals(clusters.size() * 3, 0.0f);
+    float meshCentroid[3] = {0.0f, 0.0f, 0.0f};
+    float meshArea = 0.0f;
+
+    for (size_t c = 0; c < clusters.size(); c++) {
+        size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+        float area = 0.0f;
+
+        for (size_t t = clusters[c]; t < end; t++) {
+            const float *p0 = vertices[indices[t * 3 + 0]].position;
+            const float *p1 = vertices[indices[t * 3 + 1]].position;
+            const float *p2 = vertices[indices[t * 3 + 2]].position;
+
+            float e1[3] = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+            float e2[3] = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+            float cross[3] = {
+                e1[1] * e2[2] - e1[2] * e2[1],
+                e1[2] * e2[0] - e1[0] * e2[2],
+                e1[0] * e2[1] - e1[1] * e2[0]
+            };
+
+            float triangleArea = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+
+            // Area-weighted centroid and normal (the cross product's length is already twice the area)
+            for (size_t k = 0; k < 3; k++) {
+                centroids[c * 3 + k] += (p0[k] + p1[k] + p2[k]) / 3.0f * triangleArea;
+                normals[c * 3 + k] += cross[k];
+            }
+
+            area += triangleArea;
+        }
+
+        for (size_t k = 0; k < 3; k++) {
+            meshCentroid[k] += centroids[c * 3 + k];
+        }
+
+        if (area > 0.0f) {
+            for (size_t k = 0; k < 3; k++) {
+                centroids[c * 3 + k] /= area;
+            }
+        }
+
+        meshArea += area;
+        infos.push_back({clusters[c], end, 0.0f});
+    }
+
+    if (meshArea > 0.0f) {
+        for (size_t k = 0; k < 3; k++) {
+            meshCentroid[k] /= meshArea;
+        }
+    }
+
+    for (size_t c = 0; c < infos.size(); c++) {
+        const float *n = &normals[c * 3];
+        float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+
+        if (length == 0.0f) {
+            continue;
+        }
+
+        float key = 0.0f;
+        for (size_t k = 0; k < 3; k++) {
+            key += (centroids[c * 3 + k] - meshCentroid[k]) * n[k] / length;
+        }
+
+        infos[c].sortKey = key;
+    }
+
+    std::stable_sort(infos.begin(), infos.end(), [](const ClusterInfo& a, const ClusterInfo& b) {
+        return a.sortKey > b.sortKey;
+    });
+
+    std::vector<uint32_t> sorted;
+    sorted.reserve(indices.size());
+
+    for (const auto& info : infos) {
+        sorted.insert(sorted.end(), indices.begin() + info.begin * 3, indices.begin() + info.end * 3);
+    }
+
+    indices.swap(sorted);
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData& mesh) {
+    const uint32_t UNUSED = UINT32_MAX;
+
+    std::vector<uint32_t> remap(mesh.vertices.size(), UNUSED);
+    std::vector<Vertex> vertices;
+    vertices.reserve(mesh.vertices.size());
+
+    for (auto& index : mesh.indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = static_cast<uint32_t>(vertices.size());
+            vertices.push_back(mesh.vertices[index]);
+        }
+
+        index = remap[index];
+    }
+
+    mesh.vertices.swap(vertices);
+}
@@ -0,0 +1,52 @@
+#ifndef MESH_OPTIMIZER_HXX
+#define MESH_OPTIMIZER_HXX
+
+#include <vector>
+#include <cstdint>
+
+#include "MeshFile.hxx"
+
+class MeshOptimizer {
+public:
+    /**
+     * Runs the vertex cache, overdraw and vertex fetch optimizations, in that order.
+     *
+     * @param mesh mesh to optimize in place
+     * @param cacheSize size of the post-transform cache to optimize for
+     */
+    static void optimize(MeshData& mesh, uint32_t cacheSize = 16);
+
+    /**
+     * Reorders triangles for post-transform vertex cache reuse using Tipsify
+     * (Sander, Nehab & Barczak, "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw").
+     *
+     * @param indices triangle list indices
+     * @param vertexCount number of vertices referenced by the indices
+     * @param cacheSize size of the cache to optimize for
+     * @param clusters if not null, receives the first triangle of every cluster that can be
+     *                 reordered without hurting cache reuse much
+     * @return the reordered indices
+     */
+    static std::vector<uint32_t> optimizeVertexCache(const std::vector<uint32_t>& indices, size_t vertexCount,
+        uint32_t cacheSize, std::vector<size_t> *clusters);
+
+    /**
+     * Sorts clusters so that outward-facing clusters on the outside of the mesh are drawn first,
+     * which lets early depth testing reject more of the fragments that follow.
+     *
+     * @param indices triangle list indices, reordered in place
+     * @param vertices vertices the indices refer to
+     * @param clusters first triangle of every cluster, as returned by optimizeVertexCache()
+     */
+    static void optimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices,
+        const std::vector<size_t>& clusters);
+
+    /**
+     * Reorders vertices by first use in the index buffer and drops unreferenced ones.
+     *
+     * @param mesh mesh to reorder in place
+     */
+    static void optimizeVertexFetch(MeshData& mesh);
+};
+
+#endif // MESH_OPTIMIZER_HXX
@@ -0,0 +1,116 @@
+#include <iostream>
+
+#include "QueueSubmitter.hxx"
+
+QueueSubmitter::QueueSubmitter(vk::Device *logicalDevice, uint32_t familyIndex, uint32_t queueIndex) {
+    m_logicalDevice = logicalDevice;
+    m_familyIndex = familyIndex;
+
+    m_logicalDevice->getQueue(m_familyIndex, queueIndex, &m_queue);
+
+    // Transient pool for short-lived work such as uploads and compute passes
+    vk::CommandPoolCreateInfo poolInfo(vk::CommandPoolCreateFlagBits::eTransient |
+        vk::CommandPoolCreateFlagBits::eResetCommandBuffer, m_familyIndex);
+
+    vk::SemaphoreTypeCreateInfo typeInfo(vk::SemaphoreType::eTimeline, 0);
+    vk::SemaphoreCreateInfo semInfo;
+    semInfo.pNext = &typeInfo;
+
+    try {
+        m_commandPool = m_logicalDevice->createCommandPool(poolInfo);
+        m_timeline = m_logicalDevice->createSemaphore(semInfo);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to set up queue submitter." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+}
+
+QueueSubmitter::~QueueSubmitter() {
+    m_logicalDevice->destroySemaphore(m_timeline);
+    m_logicalDevice->destroyCommandPool(m_commandPool);
+}
+
+vk::Queue *QueueSubmitter::queue() {
+    return &m_queue;
+}
+
+uint32_t QueueSubmitter::familyIndex() {
+    return m_familyIndex;
+}
+
+vk::CommandPool *QueueSubmitter::commandPool() {
+    return &m_commandPool;
+}
+
+vk::Semaphore *QueueSubmitter::timeline() {
+    return &m_timeline;
+}
+
+uint64_t QueueSubmitter::lastSubmitted() {
+    return m_lastSubmitted;
+}
+
+uint64_t QueueSubmitter::completed() {
+    return m_logicalDevice->getSemaphoreCounterValue(m_timeline);
+}
+
+uint64_t QueueSubmitter::submit(const std::vector<vk::CommandBuffer>& commandBuffers,
+    const std::vector<SubmitWait>& waits, const std::vector<vk::Semaphore>& binarySignals) {
+    std::vector<vk::Semaphore> waitSemaphores;
+    std::vector<uint64_t> waitValues;
+    std::vector<vk::PipelineStageFlags> waitStages;
+
+    for (const auto& wait : waits) {
+        waitSemaphores.push_back(wait.semaphore);
+        waitValues.push_back(wait.value);
+        waitStages.push_back(wait.stage);
+    }
+
+    uint64_t signalValue = m_lastSubmitted + 1;
+
+    // The timeline always comes first; values for binary semaphores are ignored
+    std::vector<vk::Semaphore> signalSemaphores = {m_timeline};
+    std::vector<uint64_t> signalValues = {signalValue};
+
+    for (const auto& semaphore : binarySignals) {
+        signalSemaphores.push_back(semaphore);
+        signalValues.push_back(0);
+    }
+
+    vk::TimelineSemaphoreSubmitInfo timelineInfo(static_cast<uint32_t>(waitValues.size()), waitValues.data(),
+        static_cast<uint32_t>(signalValues.size()), signalValues.data());
+
+    vk::SubmitInfo submitInfo(static_cast<uint32_t>(waitSemaphores.size()), waitSemaphores.data(),
+        waitStages.data(), static_cast<uint32_t>(commandBuffers.size()), commandBuffers.data(),
+        static_cast<uint32_t>(signalSemaphores.size()), signalSemaphores.data());
+    submitInfo.pNext = &timelineInfo;
+
+    try {
+        m_queue.submit(submitInfo, nullptr);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to submit to queue family " << m_familyIndex << "." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+
+    m_lastSubmitted = signalValue;
+
+    return signalValue;
+}
+
+bool QueueSubmitter::wait(uint64_t value, uint64_t timeout) {
+    if (value == 0) {
+        return true;
+    }
+
+    vk::SemaphoreWaitInfo waitInfo({}, 1, &m_timeline, &value);
+
+    return m_logicalDevice->waitSemaphores(waitInfo, timeout) == vk::Result::eSuccess;
+}
+
+std::vector<SubmitWait> QueueSubmitter::waitForLatest(vk::PipelineStageFlags stage) {
+    if (m_lastSubmitted == 0) {
+        return {};
+    }
+
+    return {{m_timeline, m_lastSubmitted, stage}};
+}
@@ -0,0 +1,78 @@
+#ifndef QUEUE_SUBMITTER_HXX
+#define QUEUE_SUBMITTER_HXX
+
+#include <vector>
+#include <cstdint>
+#include <vulkan/vulkan.hpp>
+
+/**
+ * A semaphore (binary or timeline) that a submission must wait on.
+ *
+ * For binary semaphores the value is ignored.
+ */
+struct SubmitWait {
+    vk::Semaphore semaphore;
+    uint64_t value;
+    vk::PipelineStageFlags stage;
+};
+
+class QueueSubmitter {
+public:
+    QueueSubmitter(vk::Device *logicalDevice, uint32_t familyIndex, uint32_t queueIndex);
+    ~QueueSubmitter();
+
+    vk::Queue *queue();
+    uint32_t familyIndex();
+    vk::CommandPool *commandPool();
+
+    /**
+     * The timeline semaphore signalled by every submission on this queue.
+     */
+    vk::Semaphore *timeline();
+
+    /**
+     * The timeline value that the most recent submission will signal.
+     */
+    uint64_t lastSubmitted();
+
+    /**
+     * Queries the timeline value the GPU has reached on this queue.
+     */
+    uint64_t completed();
+
+    /**
+     * Submits command buffers to the queue and signals the next timeline value.
+     *
+     * @param commandBuffers command buffers to execute, may be empty
+     * @param waits semaphores to wait on before execution
+     * @param binarySignals binary semaphores to signal alongside the timeline (e.g. for presentation)
+     * @return the timeline value that will be signalled once the work completes
+     */
+    uint64_t submit(const std::vector<vk::CommandBuffer>& commandBuffers,
+        const std::vector<SubmitWait>& waits = {}, const std::vector<vk::Semaphore>& binarySignals = {});
+
+    /**
+     * Blocks the calling thread until the timeline reaches the given value.
+     *
+     * @param value timeline value to wait for
+     * @param timeout timeout in nanoseconds
+     * @return true if the value was reached before the timeout
+     */
+    bool wait(uint64_t value, uint64_t timeout = UINT64_MAX);
+
+    /**
+     * Builds a wait on this queue's latest submission, or an empty list if nothing was submitted.
+     *
+     * @param stage pipeline stage that depends on the work
+     */
+    std::vector<SubmitWait> waitForLatest(vk::PipelineStageFlags stage);
+private:
+    vk::Device *m_logicalDevice;
+    vk::Queue m_queue;
+    uint32_t m_familyIndex;
+    vk::CommandPool m_commandPool;
+    vk::Semaphore m_timeline;
+    uint64_t m_lastSubmitted = 0;
+};
+
+#endif // QUEUE_SUBMITTER_HXX
@@ -1,6 +1,7 @@
 #include <iostream>
 
 #include "Render.hxx"
+#include "DebugUtils.hxx"
 
 Render::Render(vk::Device *logicalDevice, vk::Format swapChainImageFormat) {
     m_logicalDevice = logicalDevice;
@@ -26,12 +27,13 @@ Render::Render(vk::Device *logicalDevice, vk::Format swapChainImageFormat) {
     renderPassInfo.pDependencies = &dependency;
 
     try {
-        m_logicalDevice->createRenderPass(&renderPassInfo, {}, &m_renderPass, {});
+        m_logicalDevice->createRenderPass(&renderPassInfo, {}, &m_renderPass);
     } catch (std::system_error e) {
         std::cerr << "Failed to create render pass." << std::endl;
         throw std::runtime_error(e.what());
     }
 
+    DebugUtils::setName(*m_logicalDevice, m_renderPass, "triangle render pass");
 }
 
 Render::~Render() {
@@ -0,0 +1,146 @@
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+#include "RenderThread.hxx"
+
+RenderThread::RenderThread(VulkanWindow *window, std::chrono::microseconds frameInterval) {
+    m_window = window;
+    m_frameInterval = frameInterval;
+
+    m_thread = std::thread(&RenderThread::renderLoop, this);
+}
+
+RenderThread::~RenderThread() {
+    if (m_thread.joinable()) {
+        try {
+            stop();
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+}
+
+bool RenderThread::pushInput(const InputEvent& event) {
+    if (!m_input.tryPush(event)) {
+        m_droppedEvents++;
+        return false;
+    }
+
+    return true;
+}
+
+bool RenderThread::running() {
+    return m_running.load(std::memory_order_acquire);
+}
+
+void RenderThread::stop() {
+    m_stopping.store(true, std::memory_order_release);
+    m_thread.join();
+
+    // The render thread has finished with the device, so it is safe to touch it from here again
+    m_window->logicalDevice()->waitIdle();
+
+    reportLatency();
+
+    if (m_error) {
+        std::rethrow_exception(m_error);
+    }
+}
+
+void RenderThread::renderLoop() {
+    auto nextFrame = std::chrono::steady_clock::now();
+
+    try {
+        while (!m_stopping.load(std::memory_order_acquire)) {
+            std::this_thread::sleep_until(nextFrame);
+            nextFrame = std::max(nextFrame + m_frameInterval, std::chrono::steady_clock::now());
+
+            // Input is drained as late as possible so the frame reflects the newest state
+            auto oldestInput = drainInput();
+
+            if (oldestInput.has_value()) {
+                m_window->setClearColor(backgroundColor());
+            }
+
+            uint64_t frameValue = m_window->drawFrame();
+            m_frames++;
+
+            // The next drawFrame() waits for this frame anyway, so waiting here only moves that
+            // wait forward and lets the completion time be observed.
+            if (oldestInput.has_value()) {
+                m_window->graphicsSubmitter()->wait(frameValue);
+
+                std::chrono::duration<double, std::milli> latency =
+                    std::chrono::steady_clock::now() - oldestInput.value();
+                m_latencies.push_back(latency.count());
+            }
+        }
+    } catch (...) {
+        m_error = std::current_exception();
+    }
+
+    m_running.store(false, std::memory_order_release);
+
+    // Wake the event thread in case it is blocked waiting for input
+    glfwPostEmptyEvent();
+}
+
+std::optional<std::chrono::steady_clock::time_point> RenderThread::drainInput() {
+    std::optional<std::chrono::steady_clock::time_point> oldest;
+    InputEvent event;
+
+    while (m_input.tryPop(event)) {
+        if (!oldest.has_value()) {
+            oldest = event.time;
+        }
+
+        switch (event.type) {
+            case InputEvent::Type::CursorMove:
+                m_inputState.cursorX = event.x;
+                m_inputState.cursorY = event.y;
+                break;
+            case InputEvent::Type::MouseButton:
+                if (event.action == GLFW_PRESS) {
+                    m_inputState.buttonsDown |= 1u << event.code;
+                } else if (event.action == GLFW_RELEASE) {
+                    m_inputState.buttonsDown &= ~(1u << event.code);
+                }
+                break;
+            case InputEvent::Type::Key:
+                break;
+        }
+    }
+
+    return oldest;
+}
+
+std::array<float, 4> RenderThread::backgroundColor() {
+    // Kept dark so the triangle stays readable on top of it
+    const float intensity = 0.25f;
+
+    float x = static_cast<float>(m_inputState.cursorX / std::max(1u, m_window->width()));
+    float y = static_cast<float>(m_inputState.cursorY / std::max(1u, m_window->height()));
+
+    return {intensity * std::clamp(x, 0.0f, 1.0f), intensity * std::clamp(y, 0.0f, 1.0f),
+        m_inputState.buttonsDown != 0 ? intensity : 0.0f, 1.0f};
+}
+
+void RenderThread::reportLatency() {
+    std::clog << boost::format("Rendered %d frames, dropped %d input events") % m_frames % m_droppedEvents << std::endl;
+
+    if (m_latencies.empty()) {
+        return;
+    }
+
+    std::vector<double> sorted = m_latencies;
+    std::sort(sorted.begin(), sorted.end());
+
+    auto percentile = [&sorted](double p) {
+        return sorted[std::min(sorted.size() - 1, static_cast<size_t>(p * sorted.size()))];
+    };
+
+    std::clog << boost::format("Input-to-photon latency over %d frames: min %.2f ms, p50 %.2f ms, p95 %.2f ms, max %.2f ms")
+        % sorted.size() % sorted.front() % percentile(0.5) % percentile(0.95) % sorted.back() << std::endl;
+}
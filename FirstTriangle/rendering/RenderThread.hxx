@@ -0,0 +1,123 @@
+#ifndef RENDER_THREAD_HXX
+#define RENDER_THREAD_HXX
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "SpscQueue.hxx"
+#include "VulkanWindow.hxx"
+
+static const size_t INPUT_QUEUE_CAPACITY = 1024;
+
+/**
+ * A GLFW input event, stamped on the event thread when it arrived.
+ */
+struct InputEvent {
+    enum class Type {
+        Key,
+        MouseButton,
+        CursorMove
+    };
+
+    Type type = Type::Key;
+    int code = 0;
+    int action = 0;
+    double x = 0.0;
+    double y = 0.0;
+    std::chrono::steady_clock::time_point time;
+};
+
+/**
+ * Cursor and button state as last seen by the render thread. The background color follows it: the
+ * cursor position picks red and green, and holding any mouse button adds blue.
+ */
+struct InputState {
+    double cursorX = 0.0;
+    double cursorY = 0.0;
+    uint32_t buttonsDown = 0;
+};
+
+/**
+ * Owns drawing and presentation for a VulkanWindow on a dedicated thread, so that event handling on
+ * the main thread and blocking presents never delay each other.
+ *
+ * Once started, only the render thread touches the window's device. The main thread keeps the GLFW
+ * window itself (GLFW requires it) and forwards input through pushInput().
+ *
+ * Input-to-photon latency is measured as the time from an event being stamped to the graphics
+ * timeline reaching the frame that consumed it, and reported when the thread stops. Scanout after
+ * the present is not included.
+ */
+class RenderThread {
+public:
+    /**
+     * Starts the render thread.
+     *
+     * @param window window to draw; must outlive the render thread
+     * @param frameInterval minimum time between frames, or zero to draw as fast as presentation allows
+     */
+    RenderThread(VulkanWindow *window, std::chrono::microseconds frameInterval);
+
+    /**
+     * Stops the thread if stop() was not called.
+     */
+    ~RenderThread();
+
+    /**
+     * Forwards an input event to the render thread. Main thread only.
+     *
+     * @return false if the queue is full and the event was dropped
+     */
+    bool pushInput(const InputEvent& event);
+
+    /**
+     * Whether the render thread is still drawing. It stops on its own if drawing throws.
+     */
+    bool running();
+
+    /**
+     * Stops and joins the render thread, waits for the device to go idle and reports latency.
+     *
+     * Rethrows anything the render thread threw.
+     */
+    void stop();
+private:
+    VulkanWindow *m_window;
+    std::chrono::microseconds m_frameInterval;
+
+    SpscQueue<InputEvent, INPUT_QUEUE_CAPACITY> m_input;
+    InputState m_inputState;
+    size_t m_droppedEvents = 0;
+
+    std::thread m_thread;
+    std::atomic<bool> m_stopping{false};
+    std::atomic<bool> m_running{true};
+    std::exception_ptr m_error;
+
+    // Render thread only
+    std::vector<double> m_latencies;
+    uint64_t m_frames = 0;
+
+    void renderLoop();
+
+    /**
+     * Applies every queued event to the input state.
+     *
+     * @return time of the oldest event drained, or nothing if the queue was empty
+     */
+    std::optional<std::chrono::steady_clock::time_point> drainInput();
+
+    /**
+     * The background color for the current input state.
+     */
+    std::array<float, 4> backgroundColor();
+
+    void reportLatency();
+};
+
+#endif // RENDER_THREAD_HXX
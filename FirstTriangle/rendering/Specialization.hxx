@@ -0,0 +1,94 @@
+#ifndef SPECIALIZATION_HXX
+#define SPECIALIZATION_HXX
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vulkan/vulkan.hpp>
+
+/**
+ * Describes one specialization constant a shader exposes, matching a
+ * `layout(constant_id = Id) const ...` declaration in GLSL.
+ *
+ * GLSL bools are 32 bits wide, so boolean constants use VkBool32.
+ */
+template<uint32_t Id, typename T>
+struct SpecConstant {
+    static_assert(std::is_same<T, VkBool32>::value || std::is_same<T, int32_t>::value ||
+        std::is_same<T, float>::value, "Specialization constants must be VkBool32, int32_t or float");
+
+    static constexpr uint32_t id = Id;
+    using Type = T;
+};
+
+namespace specialization_detail {
+    template<typename... Constants>
+    constexpr uint32_t offsetOf(size_t index) {
+        // Leading zero keeps the array valid when there are no constants
+        const size_t sizes[] = {0u, sizeof(typename Constants::Type)...};
+        uint32_t offset = 0;
+
+        for (size_t i = 0; i < index; i++) {
+            offset += static_cast<uint32_t>(sizes[i + 1]);
+        }
+
+        return offset;
+    }
+
+    template<typename... Constants, size_t... Indices>
+    constexpr std::array<vk::SpecializationMapEntry, sizeof...(Constants)> mapEntries(std::index_sequence<Indices...>) {
+        return {{vk::SpecializationMapEntry(Constants::id, offsetOf<Constants...>(Indices),
+            sizeof(typename Constants::Type))...}};
+    }
+
+    template<typename... Constants>
+    constexpr bool idsUnique() {
+        const uint32_t ids[] = {0u, Constants::id...};
+
+        for (size_t i = 1; i < sizeof(ids) / sizeof(ids[0]); i++) {
+            for (size_t j = i + 1; j < sizeof(ids) / sizeof(ids[0]); j++) {
+                if (ids[i] == ids[j]) {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+/**
+ * Values for a set of specialization constants, packed in declaration order.
+ *
+ * The map entries are built at compile time from the SpecConstant descriptors, so only the values
+ * are filled in at runtime. Duplicate constant IDs are rejected at compile time.
+ */
+template<typename... Constants>
+class Specialization {
+    static_assert(specialization_detail::idsUnique<Constants...>(), "Specialization constant IDs must be unique");
+public:
+    static constexpr size_t COUNT = sizeof...(Constants);
+    static constexpr size_t DATA_SIZE = (sizeof(typename Constants::Type) + ... + 0);
+    static constexpr std::array<vk::SpecializationMapEntry, COUNT> MAP_ENTRIES =
+        specialization_detail::mapEntries<Constants...>(std::index_sequence_for<Constants...>());
+
+    explicit Specialization(typename Constants::Type... values) {
+        size_t offset = 0;
+        ((std::memcpy(m_data.data() + offset, &values, sizeof(values)), offset += sizeof(values)), ...);
+    }
+
+    /**
+     * Points into this object, which must outlive the pipeline creation it is used for.
+     */
+    const vk::SpecializationInfo *info() {
+        m_info = vk::SpecializationInfo(static_cast<uint32_t>(COUNT), MAP_ENTRIES.data(), DATA_SIZE, m_data.data());
+        return &m_info;
+    }
+private:
+    std::array<uint8_t, DATA_SIZE> m_data{};
+    vk::SpecializationInfo m_info;
+};
+
+#endif // SPECIALIZATION_HXX
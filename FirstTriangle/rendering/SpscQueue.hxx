@@ -0,0 +1,76 @@
+#ifndef SPSC_QUEUE_HXX
+#define SPSC_QUEUE_HXX
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * The indices only ever grow and are masked into the ring, so Capacity must be a power of two.
+ * Each side keeps a cached copy of the other side's index and only reloads it when the ring looks
+ * full (or empty), which keeps the shared cache lines from bouncing on every call.
+ */
+template<typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+public:
+    /**
+     * Adds an element. Producer thread only.
+     *
+     * @return false if the queue is full; the element is not added
+     */
+    bool tryPush(const T& value) {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+
+        if (tail - m_headCache == Capacity) {
+            m_headCache = m_head.load(std::memory_order_acquire);
+
+            if (tail - m_headCache == Capacity) {
+                return false;
+            }
+        }
+
+        m_slots[tail & (Capacity - 1)] = value;
+        m_tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Removes the oldest element. Consumer thread only.
+     *
+     * @return false if the queue is empty; value is left untouched
+     */
+    bool tryPop(T& value) {
+        size_t head = m_head.load(std::memory_order_relaxed);
+
+        if (head == m_tailCache) {
+            m_tailCache = m_tail.load(std::memory_order_acquire);
+
+            if (head == m_tailCache) {
+                return false;
+            }
+        }
+
+        value = m_slots[head & (Capacity - 1)];
+        m_head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+private:
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    // Written by the producer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_tail{0};
+    size_t m_headCache = 0;
+
+    // Written by the consumer
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_head{0};
+    size_t m_tailCache = 0;
+
+    alignas(CACHE_LINE_SIZE) std::array<T, Capacity> m_slots;
+};
+
+#endif // SPSC_QUEUE_HXX
@@ -0,0 +1,92 @@
+#include "StagingRing.hxx"
+
+static vk::DeviceSize alignUp(vk::DeviceSize value, vk::DeviceSize alignment) {
+    return (value + alignment - 1) / alignment * alignment;
+}
+
+StagingRing::StagingRing(vk::PhysicalDevice physicalDevice, vk::Device *logicalDevice, vk::DeviceSize capacity) {
+    m_buffer = new Buffer(physicalDevice, logicalDevice, capacity, vk::BufferUsageFlagBits::eTransferSrc,
+        {vk::MemoryPropertyFlagBits::eHostVisible | vk::MemoryPropertyFlagBits::eHostCoherent,
+         vk::MemoryPropertyFlagBits::eHostVisible});
+
+    // Stays mapped for the lifetime of the ring
+    m_mapped = static_cast<char*>(m_buffer->map());
+}
+
+StagingRing::~StagingRing() {
+    m_buffer->unmap();
+    delete m_buffer;
+}
+
+vk::Buffer *StagingRing::buffer() {
+    return m_buffer->buffer();
+}
+
+vk::DeviceSize StagingRing::capacity() {
+    return m_buffer->size();
+}
+
+std::optional<vk::DeviceSize> StagingRing::allocate(vk::DeviceSize size, vk::DeviceSize alignment) {
+    vk::DeviceSize capacity = m_buffer->size();
+
+    // An empty region starting at the head would make an empty ring look full
+    if (size == 0) {
+        return 0;
+    }
+
+    if (m_regions.empty()) {
+        m_head = 0;
+    }
+
+    vk::DeviceSize offset = alignUp(m_head, alignment);
+
+    if (m_regions.empty()) {
+        if (size > capacity) {
+            return std::nullopt;
+        }
+    } else {
+        vk::DeviceSize tail = m_regions.front().begin;
+
+        if (m_head > tail) {
+            // Free space is [head, capacity) followed by [0, tail)
+            if (offset + size > capacity) {
+                if (size > tail) {
+                    return std::nullopt;
+                }
+
+                offset = 0;
+            }
+        } else {
+            // Free space is [head, tail); head == tail means the ring is full
+            if (offset + size > tail || m_head == tail) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    m_regions.push_back({offset, offset + size, 0});
+    m_head = offset + size;
+
+    return offset;
+}
+
+char *StagingRing::data(vk::DeviceSize offset) {
+    return m_mapped + offset;
+}
+
+void StagingRing::flush() {
+    // Flushing the whole mapping sidesteps nonCoherentAtomSize alignment of partial ranges
+    m_buffer->flush();
+}
+
+void StagingRing::commit(uint64_t value) {
+    for (auto it = m_regions.rbegin(); it != m_regions.rend() && it->value == 0; it++) {
+        it->value = value;
+    }
+}
+
+void StagingRing::reclaim(uint64_t completedValue) {
+    while (!m_regions.empty() && m_regions.front().value != 0 && m_regions.front().value <= completedValue) {
+        m_regions.pop_front();
+    }
+}
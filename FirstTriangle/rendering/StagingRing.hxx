@@ -0,0 +1,67 @@
+#ifndef STAGING_RING_HXX
+#define STAGING_RING_HXX
+
+#include <deque>
+#include <optional>
+#include <vulkan/vulkan.hpp>
+
+#include "Buffer.hxx"
+
+/**
+ * A persistently mapped upload buffer that is handed out front to back and recycled once the
+ * transfers reading from it have completed on the GPU.
+ */
+class StagingRing {
+public:
+    StagingRing(vk::PhysicalDevice physicalDevice, vk::Device *logicalDevice, vk::DeviceSize capacity);
+    ~StagingRing();
+
+    vk::Buffer *buffer();
+    vk::DeviceSize capacity();
+
+    /**
+     * Reserves space in the ring without blocking.
+     *
+     * @param size number of bytes needed; zero-sized requests get offset 0 and reserve nothing
+     * @param alignment required alignment of the returned offset
+     * @return the offset into the buffer, or nothing if the ring is currently full
+     */
+    std::optional<vk::DeviceSize> allocate(vk::DeviceSize size, vk::DeviceSize alignment);
+
+    /**
+     * Pointer to the mapped memory at the given offset.
+     */
+    char *data(vk::DeviceSize offset);
+
+    /**
+     * Makes host writes visible to the device for non-coherent memory.
+     */
+    void flush();
+
+    /**
+     * Associates every allocation made since the last commit with a timeline value.
+     *
+     * @param value timeline value that signals the transfers reading those allocations are done
+     */
+    void commit(uint64_t value);
+
+    /**
+     * Recycles allocations whose timeline value has been reached.
+     *
+     * @param completedValue value the timeline has reached
+     */
+    void reclaim(uint64_t completedValue);
+private:
+    struct Region {
+        vk::DeviceSize begin;
+        vk::DeviceSize end;
+        uint64_t value;
+    };
+
+    Buffer *m_buffer;
+    char *m_mapped;
+    vk::DeviceSize m_head = 0;
+    std::deque<Region> m_regions;
+};
+
+#endif // STAGING_RING_HXX
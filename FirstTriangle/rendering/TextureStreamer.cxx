@@ -0,0 +1,452 @@
+#include <algorithm>
+#include <iostream>
+#include <set>
+#include <cstring>
+
+#include "TextureStreamer.hxx"
+#include "Buffer.hxx"
+
+namespace {
+    // Textures first become visible with their mip chain from this size down
+    const uint32_t COARSE_SIZE = 64;
+    // Soft cap on bytes copied into the staging ring per frame
+    const vk::DeviceSize UPLOAD_BYTES_PER_FRAME = 8 * 1024 * 1024;
+    const vk::DeviceSize STAGING_ALIGNMENT = 16;
+    const vk::Format TEXTURE_FORMAT = vk::Format::eR8G8B8A8Srgb;
+
+    vk::ImageMemoryBarrier layoutBarrier(vk::Image image, uint32_t baseLevel, uint32_t levelCount,
+        vk::ImageLayout oldLayout, vk::ImageLayout newLayout, vk::AccessFlags srcAccess, vk::AccessFlags dstAccess) {
+        vk::ImageSubresourceRange range(vk::ImageAspectFlagBits::eColor, baseLevel, levelCount, 0, 1);
+
+        return vk::ImageMemoryBarrier(srcAccess, dstAccess, oldLayout, newLayout,
+            VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, image, range);
+    }
+}
+
+TextureStreamer::TextureStreamer(vk::PhysicalDevice physicalDevice, vk::Device *logicalDevice, QueueSubmitter *transfer,
+    QueueSubmitter *graphics, ThreadPool *pool, vk::DeviceSize residencyBudget, vk::DeviceSize stagingSize) {
+    m_physicalDevice = physicalDevice;
+    m_logicalDevice = logicalDevice;
+    m_transfer = transfer;
+    m_graphics = graphics;
+    m_pool = pool;
+    m_budget = residencyBudget;
+
+    m_staging = new StagingRing(m_physicalDevice, m_logicalDevice, stagingSize);
+
+    vk::SamplerCreateInfo samplerInfo({}, vk::Filter::eLinear, vk::Filter::eLinear, vk::SamplerMipmapMode::eLinear,
+        vk::SamplerAddressMode::eRepeat, vk::SamplerAddressMode::eRepeat, vk::SamplerAddressMode::eRepeat,
+        0.0f, false, 1.0f, false, vk::CompareOp::eAlways, 0.0f, VK_LOD_CLAMP_NONE);
+
+    try {
+        m_sampler = m_logicalDevice->createSampler(samplerInfo);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to create texture sampler." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+}
+
+TextureStreamer::~TextureStreamer() {
+    m_transfer->wait(m_transfer->lastSubmitted());
+    m_graphics->wait(m_graphics->lastSubmitted());
+
+    for (auto& retired : m_retired) {
+        m_logicalDevice->destroyImageView(retired.view);
+        m_logicalDevice->destroyImage(retired.image);
+        m_logicalDevice->freeMemory(retired.memory);
+    }
+
+    for (auto& texture : m_textures) {
+        if (texture.uploading) {
+            m_logicalDevice->freeCommandBuffers(*m_transfer->commandPool(), texture.transferCommands);
+            m_logicalDevice->freeCommandBuffers(*m_graphics->commandPool(), texture.graphicsCommands);
+        }
+
+        m_logicalDevice->destroyImageView(texture.view);
+        m_logicalDevice->destroyImage(texture.image);
+        m_logicalDevice->freeMemory(texture.memory);
+    }
+
+    m_logicalDevice->destroySampler(m_sampler);
+    delete m_staging;
+}
+
+TextureHandle TextureStreamer::request(const std::filesystem::path& filename) {
+    m_textures.emplace_back();
+
+    Texture& texture = m_textures.back();
+    texture.path = filename;
+    texture.lastUsedFrame = m_frame;
+    startDecode(texture);
+
+    return static_cast<TextureHandle>(m_textures.size() - 1);
+}
+
+void TextureStreamer::update(uint64_t frame) {
+    m_frame = frame;
+
+    m_staging->reclaim(m_transfer->completed());
+
+    uint64_t graphicsDone = m_graphics->completed();
+
+    // Destroy views and images that no in-flight frame can reference anymore
+    auto firstLive = std::partition(m_retired.begin(), m_retired.end(), [&](const Retired& retired) {
+        return retired.graphicsValue <= graphicsDone;
+    });
+
+    for (auto it = m_retired.begin(); it != firstLive; it++) {
+        m_logicalDevice->destroyImageView(it->view);
+        m_logicalDevice->destroyImage(it->image);
+        m_logicalDevice->freeMemory(it->memory);
+    }
+
+    m_retired.erase(m_retired.begin(), firstLive);
+
+    for (auto& texture : m_textures) {
+        if (texture.uploading && texture.pendingValue <= graphicsDone) {
+            publish(texture);
+        }
+
+        if (texture.state == TextureState::Decoding &&
+            texture.decoding.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            try {
+                texture.decoded = texture.decoding.get();
+                texture.state = TextureState::Decoded;
+            } catch (const std::exception& e) {
+                std::cerr << "Failed to decode texture " << texture.path << ": " << e.what() << std::endl;
+                texture.state = TextureState::Failed;
+            }
+        }
+    }
+
+    vk::DeviceSize uploaded = 0;
+
+    // Coarse mips for everything that is waiting before refining anything
+    for (auto& texture : m_textures) {
+        if (texture.state != TextureState::Decoded || texture.uploading) {
+            continue;
+        }
+
+        if (uploaded >= UPLOAD_BYTES_PER_FRAME) {
+            return;
+        }
+
+        const ImageData& coarse = texture.decoded.coarseMip == 0 ? texture.decoded.full : texture.decoded.coarse;
+
+        if (coarse.pixels.size() > m_staging->capacity()) {
+            std::cerr << "Texture " << texture.path << " does not fit in the staging ring." << std::endl;
+            texture.state = TextureState::Failed;
+            continue;
+        }
+
+        if (!texture.image && !createImage(texture)) {
+            continue;
+        }
+
+        if (!uploadLevel(texture, coarse, texture.decoded.coarseMip, texture.mipLevels, true)) {
+            // Staging ring is full until earlier transfers retire
+            return;
+        }
+
+        uploaded += coarse.pixels.size();
+
+        if (texture.decoded.coarseMip == 0) {
+            // The coarse upload already covered mip 0
+            texture.finished = true;
+            texture.decoded = DecodedImage();
+        } else if (texture.decoded.full.pixels.size() > m_staging->capacity()) {
+            std::cerr << "Texture " << texture.path << " stays at mip " << texture.decoded.coarseMip
+                << ", its full size does not fit in the staging ring." << std::endl;
+            texture.finished = true;
+            texture.decoded = DecodedImage();
+        } else {
+            // Only the full image is needed to refine
+            texture.decoded.coarse = ImageData();
+        }
+    }
+
+    // Refine the most recently used textures first
+    std::vector<Texture*> refinable;
+    for (auto& texture : m_textures) {
+        if (texture.state == TextureState::Coarse && !texture.uploading && !texture.finished) {
+            refinable.push_back(&texture);
+        }
+    }
+
+    std::stable_sort(refinable.begin(), refinable.end(), [](const Texture *a, const Texture *b) {
+        return a->lastUsedFrame > b->lastUsedFrame;
+    });
+
+    for (auto texture : refinable) {
+        if (uploaded >= UPLOAD_BYTES_PER_FRAME) {
+            return;
+        }
+
+        if (!uploadLevel(*texture, texture->decoded.full, 0, texture->decoded.coarseMip, false)) {
+            return;
+        }
+
+        uploaded += texture->decoded.full.pixels.size();
+
+        // The pixels now live in the staging ring
+        texture->finished = true;
+        texture->decoded = DecodedImage();
+    }
+}
+
+vk::ImageView *TextureStreamer::view(TextureHandle handle) {
+    Texture& texture = m_textures.at(handle);
+    texture.lastUsedFrame = m_frame;
+
+    if (texture.state == TextureState::Evicted) {
+        startDecode(texture);
+    }
+
+    if (texture.state == TextureState::Coarse || texture.state == TextureState::Resident) {
+        return &texture.view;
+    }
+
+    return nullptr;
+}
+
+uint32_t TextureStreamer::residentMip(TextureHandle handle) {
+    return m_textures.at(handle).residentMip;
+}
+
+vk::Sampler *TextureStreamer::sampler() {
+    return &m_sampler;
+}
+
+vk::DeviceSize TextureStreamer::residentBytes() {
+    return m_residentBytes;
+}
+
+void TextureStreamer::startDecode(Texture& texture) {
+    texture.state = TextureState::Decoding;
+    texture.finished = false;
+
+    auto path = texture.path;
+    texture.decoding = m_pool->enqueue([path]() {
+        DecodedImage decoded;
+        decoded.full = ImageDecoder::decode(path);
+        decoded.coarseMip = 0;
+
+        uint32_t size = std::max(decoded.full.width, decoded.full.height);
+        while ((size >> decoded.coarseMip) > COARSE_SIZE) {
+            decoded.coarseMip++;
+        }
+
+        if (decoded.coarseMip > 0) {
+            decoded.coarse = ImageDecoder::downsample(decoded.full, decoded.coarseMip);
+        }
+
+        return decoded;
+    });
+}
+
+bool TextureStreamer::createImage(Texture& texture) {
+    const ImageData& full = texture.decoded.full;
+    texture.mipLevels = ImageDecoder::mipLevelCount(full.width, full.height);
+
+    // Written on the transfer queue and blitted on the graphics queue
+    std::set<uint32_t> uniqueFamilies = {m_transfer->familyIndex(), m_graphics->familyIndex()};
+    std::vector<uint32_t> families(uniqueFamilies.begin(), uniqueFamilies.end());
+
+    vk::ImageCreateInfo imageInfo({}, vk::ImageType::e2D, TEXTURE_FORMAT, vk::Extent3D(full.width, full.height, 1),
+        texture.mipLevels, 1, vk::SampleCountFlagBits::e1, vk::ImageTiling::eOptimal,
+        vk::ImageUsageFlagBits::eTransferSrc | vk::ImageUsageFlagBits::eTransferDst | vk::ImageUsageFlagBits::eSampled);
+
+    if (families.size() > 1) {
+        imageInfo.sharingMode = vk::SharingMode::eConcurrent;
+        imageInfo.queueFamilyIndexCount = static_cast<uint32_t>(families.size());
+        imageInfo.pQueueFamilyIndices = families.data();
+    }
+
+    vk::Image image = m_logicalDevice->createImage(imageInfo);
+    vk::MemoryRequirements requirements = m_logicalDevice->getImageMemoryRequirements(image);
+
+    // A texture bigger than the whole budget is still allowed in on its own
+    while (m_residentBytes > 0 && m_residentBytes + requirements.size > m_budget) {
+        if (!evictLeastRecentlyUsed()) {
+            m_logicalDevice->destroyImage(image);
+            return false;
+        }
+    }
+
+    auto memoryType = Buffer::findMemoryType(m_physicalDevice, requirements.memoryTypeBits,
+        vk::MemoryPropertyFlagBits::eDeviceLocal);
+
+    if (!memoryType.has_value()) {
+        m_logicalDevice->destroyImage(image);
+        throw std::runtime_error("Failed to find a suitable memory type for texture.");
+    }
+
+    vk::MemoryAllocateInfo allocateInfo(requirements.size, memoryType.value());
+
+    try {
+        texture.memory = m_logicalDevice->allocateMemory(allocateInfo);
+        m_logicalDevice->bindImageMemory(image, texture.memory, 0);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to allocate texture memory." << std::endl;
+        m_logicalDevice->destroyImage(image);
+        throw std::runtime_error(e.what());
+    }
+
+    texture.image = image;
+    texture.size = requirements.size;
+    texture.residentMip = texture.mipLevels;
+    m_residentBytes += texture.size;
+
+    return true;
+}
+
+bool TextureStreamer::uploadLevel(Texture& texture, const ImageData& pixels, uint32_t level, uint32_t lastLevel,
+    bool firstUpload) {
+    auto offset = m_staging->allocate(pixels.pixels.size(), STAGING_ALIGNMENT);
+
+    if (!offset.has_value()) {
+        return false;
+    }
+
+    std::memcpy(m_staging->data(offset.value()), pixels.pixels.data(), pixels.pixels.size());
+    m_staging->flush();
+
+    vk::CommandBufferAllocateInfo transferAllocate(*m_transfer->commandPool(), vk::CommandBufferLevel::ePrimary, 1);
+    vk::CommandBufferAllocateInfo graphicsAllocate(*m_graphics->commandPool(), vk::CommandBufferLevel::ePrimary, 1);
+
+    try {
+        texture.transferCommands = m_logicalDevice->allocateCommandBuffers(transferAllocate)[0];
+        texture.graphicsCommands = m_logicalDevice->allocateCommandBuffers(graphicsAllocate)[0];
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to allocate texture upload command buffers." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+
+    vk::CommandBufferBeginInfo beginInfo(vk::CommandBufferUsageFlagBits::eOneTimeSubmit);
+
+    // Transfer queue: copy the whole level out of the staging ring. Copies that cover an entire mip
+    // level are valid at any minImageTransferGranularity, including (0,0,0) on DMA-only families.
+    vk::CommandBuffer transfer = texture.transferCommands;
+    transfer.begin(beginInfo);
+
+    if (firstUpload) {
+        auto barrier = layoutBarrier(texture.image, 0, texture.mipLevels, vk::ImageLayout::eUndefined,
+            vk::ImageLayout::eTransferDstOptimal, {}, vk::AccessFlagBits::eTransferWrite);
+        transfer.pipelineBarrier(vk::PipelineStageFlagBits::eTopOfPipe, vk::PipelineStageFlagBits::eTransfer,
+            {}, nullptr, nullptr, barrier);
+    }
+
+    vk::BufferImageCopy region(offset.value(), 0, 0, vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, level, 0, 1),
+        vk::Offset3D(0, 0, 0), vk::Extent3D(pixels.width, pixels.height, 1));
+    transfer.copyBufferToImage(*m_staging->buffer(), texture.image, vk::ImageLayout::eTransferDstOptimal, region);
+
+    transfer.end();
+
+    uint64_t transferValue = m_transfer->submit({transfer});
+    m_staging->commit(transferValue);
+
+    // Graphics queue: blit the level down to generate the rest of the requested range
+    vk::CommandBuffer graphics = texture.graphicsCommands;
+    graphics.begin(beginInfo);
+
+    for (uint32_t mip = level; mip < lastLevel; mip++) {
+        auto toSource = layoutBarrier(texture.image, mip, 1, vk::ImageLayout::eTransferDstOptimal,
+            vk::ImageLayout::eTransferSrcOptimal, vk::AccessFlagBits::eTransferWrite, vk::AccessFlagBits::eTransferRead);
+        graphics.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eTransfer,
+            {}, nullptr, nullptr, toSource);
+
+        if (mip + 1 < lastLevel) {
+            vk::ImageBlit blit;
+            blit.srcSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, mip, 0, 1);
+            blit.srcOffsets[1] = vk::Offset3D(std::max(1u, pixels.width >> (mip - level)),
+                std::max(1u, pixels.height >> (mip - level)), 1);
+            blit.dstSubresource = vk::ImageSubresourceLayers(vk::ImageAspectFlagBits::eColor, mip + 1, 0, 1);
+            blit.dstOffsets[1] = vk::Offset3D(std::max(1u, pixels.width >> (mip - level + 1)),
+                std::max(1u, pixels.height >> (mip - level + 1)), 1);
+
+            graphics.blitImage(texture.image, vk::ImageLayout::eTransferSrcOptimal, texture.image,
+                vk::ImageLayout::eTransferDstOptimal, blit, vk::Filter::eLinear);
+        }
+    }
+
+    auto toShader = layoutBarrier(texture.image, level, lastLevel - level, vk::ImageLayout::eTransferSrcOptimal,
+        vk::ImageLayout::eShaderReadOnlyOptimal, vk::AccessFlagBits::eTransferRead, vk::AccessFlagBits::eShaderRead);
+    graphics.pipelineBarrier(vk::PipelineStageFlagBits::eTransfer, vk::PipelineStageFlagBits::eFragmentShader,
+        {}, nullptr, nullptr, toShader);
+
+    graphics.end();
+
+    texture.pendingValue = m_graphics->submit({graphics},
+        {{*m_transfer->timeline(), transferValue, vk::PipelineStageFlagBits::eTransfer}});
+    texture.pendingMip = level;
+    texture.uploading = true;
+
+    return true;
+}
+
+bool TextureStreamer::evictLeastRecentlyUsed() {
+    Texture *victim = nullptr;
+
+    for (auto& texture : m_textures) {
+        bool resident = texture.state == TextureState::Coarse || texture.state == TextureState::Resident;
+
+        // Anything used in the last frame is likely to be used again in this one
+        if (!resident || texture.uploading || texture.lastUsedFrame + 1 >= m_frame) {
+            continue;
+        }
+
+        if (victim == nullptr || texture.lastUsedFrame < victim->lastUsedFrame) {
+            victim = &texture;
+        }
+    }
+
+    if (victim == nullptr) {
+        return false;
+    }
+
+    destroyImage(*victim);
+    victim->decoded = DecodedImage();
+    victim->state = TextureState::Evicted;
+
+    return true;
+}
+
+void TextureStreamer::publish(Texture& texture) {
+    m_logicalDevice->freeCommandBuffers(*m_transfer->commandPool(), texture.transferCommands);
+    m_logicalDevice->freeCommandBuffers(*m_graphics->commandPool(), texture.graphicsCommands);
+    texture.uploading = false;
+
+    vk::ImageViewCreateInfo viewInfo({}, texture.image, vk::ImageViewType::e2D, TEXTURE_FORMAT, {},
+        vk::ImageSubresourceRange(vk::ImageAspectFlagBits::eColor, texture.pendingMip,
+            texture.mipLevels - texture.pendingMip, 0, 1));
+
+    vk::ImageView view;
+    try {
+        view = m_logicalDevice->createImageView(viewInfo);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to create texture image view." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+
+    // Frames already in flight may still sample through the old view
+    if (texture.view) {
+        m_retired.push_back({texture.view, nullptr, nullptr, m_graphics->lastSubmitted()});
+    }
+
+    texture.view = view;
+    texture.residentMip = texture.pendingMip;
+    texture.state = texture.residentMip == 0 ? TextureState::Resident : TextureState::Coarse;
+}
+
+void TextureStreamer::destroyImage(Texture& texture) {
+    // Deferred until the frames that may reference it have completed
+    m_retired.push_back({texture.view, texture.image, texture.memory, m_graphics->lastSubmitted()});
+
+    m_residentBytes -= texture.size;
+
+    texture.view = nullptr;
+    texture.image = nullptr;
+    texture.memory = nullptr;
+    texture.size = 0;
+    texture.residentMip = texture.mipLevels;
+}
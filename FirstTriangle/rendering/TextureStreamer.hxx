@@ -0,0 +1,169 @@
+#ifndef TEXTURE_STREAMER_HXX
+#define TEXTURE_STREAMER_HXX
+
+#include <deque>
+#include <vector>
+#include <future>
+#include <chrono>
+#include <filesystem>
+#include <vulkan/vulkan.hpp>
+
+#include "ImageDecoder.hxx"
+#include "QueueSubmitter.hxx"
+#include "StagingRing.hxx"
+#include "ThreadPool.hxx"
+
+using TextureHandle = uint32_t;
+
+class TextureStreamer {
+public:
+    /**
+     * @param physicalDevice device used to look up memory types
+     * @param logicalDevice device that owns the textures
+     * @param transfer submitter for the queue that copies from the staging ring
+     * @param graphics submitter for the queue that generates mips (blits need a graphics queue)
+     * @param pool worker pool that decodes images
+     * @param residencyBudget bytes of image memory to keep resident before evicting
+     * @param stagingSize size of the staging ring in bytes
+     */
+    TextureStreamer(vk::PhysicalDevice physicalDevice, vk::Device *logicalDevice, QueueSubmitter *transfer,
+        QueueSubmitter *graphics, ThreadPool *pool, vk::DeviceSize residencyBudget, vk::DeviceSize stagingSize);
+    ~TextureStreamer();
+
+    /**
+     * Starts streaming a texture. Decoding happens on the worker pool; nothing blocks.
+     *
+     * @param filename path to the image
+     * @return a handle to look the texture up with
+     */
+    TextureHandle request(const std::filesystem::path& filename);
+
+    /**
+     * Advances streaming by one frame: collects decoded images, issues uploads within the per-frame
+     * budget (coarse mips for every texture before any refinement), publishes finished uploads and
+     * evicts least recently used textures when over budget.
+     *
+     * Must be called from the thread that records and submits frames.
+     *
+     * @param frame monotonically increasing frame number
+     */
+    void update(uint64_t frame);
+
+    /**
+     * Looks up the image view to sample a texture through and marks it as used this frame.
+     *
+     * Evicted textures are requested again.
+     *
+     * @return the view, or nullptr while nothing is resident yet
+     */
+    vk::ImageView *view(TextureHandle handle);
+
+    /**
+     * The most detailed mip level that is currently resident, 0 once fully streamed.
+     */
+    uint32_t residentMip(TextureHandle handle);
+
+    vk::Sampler *sampler();
+    vk::DeviceSize residentBytes();
+private:
+    enum class TextureState {
+        Decoding,
+        Decoded,
+        Coarse,
+        Resident,
+        Evicted,
+        Failed
+    };
+
+    struct DecodedImage {
+        ImageData full;
+        ImageData coarse;
+        uint32_t coarseMip;
+    };
+
+    struct Texture {
+        std::filesystem::path path;
+        TextureState state;
+        std::future<DecodedImage> decoding;
+        DecodedImage decoded;
+
+        vk::Image image;
+        vk::DeviceMemory memory;
+        vk::ImageView view;
+        vk::DeviceSize size = 0;
+        uint32_t mipLevels = 0;
+        uint32_t residentMip = 0;
+
+        // Nothing further will be uploaded and the decoded pixels have been released
+        bool finished = false;
+
+        // Upload in flight, published once the graphics timeline reaches pendingValue
+        bool uploading = false;
+        uint32_t pendingMip = 0;
+        uint64_t pendingValue = 0;
+        vk::CommandBuffer transferCommands;
+        vk::CommandBuffer graphicsCommands;
+
+        uint64_t lastUsedFrame = 0;
+    };
+
+    // Resources destroyed once the graphics timeline passes graphicsValue
+    struct Retired {
+        vk::ImageView view;
+        vk::Image image;
+        vk::DeviceMemory memory;
+        uint64_t graphicsValue;
+    };
+
+    vk::PhysicalDevice m_physicalDevice;
+    vk::Device *m_logicalDevice;
+    QueueSubmitter *m_transfer;
+    QueueSubmitter *m_graphics;
+    ThreadPool *m_pool;
+    StagingRing *m_staging;
+    vk::Sampler m_sampler;
+
+    std::deque<Texture> m_textures;
+    std::vector<Retired> m_retired;
+
+    vk::DeviceSize m_budget;
+    vk::DeviceSize m_residentBytes = 0;
+    uint64_t m_frame = 0;
+
+    void startDecode(Texture& texture);
+
+    /**
+     * Creates the image and its memory, evicting other textures first if needed.
+     *
+     * @return false if there is no room within the budget this frame
+     */
+    bool createImage(Texture& texture);
+
+    /**
+     * Copies one mip level through the staging ring and generates the levels below it with blits.
+     *
+     * @param texture texture to upload to
+     * @param pixels pixels of the level
+     * @param level mip level the pixels belong to
+     * @param lastLevel one past the last level to generate from it
+     * @param firstUpload whether the image still needs its initial layout transition
+     * @return false if the staging ring is full this frame
+     */
+    bool uploadLevel(Texture& texture, const ImageData& pixels, uint32_t level, uint32_t lastLevel, bool firstUpload);
+
+    /**
+     * Evicts the least recently used resident texture, skipping anything used in the last frame.
+     *
+     * @return false if nothing could be evicted
+     */
+    bool evictLeastRecentlyUsed();
+
+    /**
+     * Makes a finished upload visible through a new view covering the newly resident mips.
+     */
+    void publish(Texture& texture);
+
+    void destroyImage(Texture& texture);
+};
+
+#endif // TEXTURE_STREAMER_HXX
@@ -0,0 +1,57 @@
+#ifndef THREAD_POOL_HXX
+#define THREAD_POOL_HXX
+
+#include <vector>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+
+class ThreadPool {
+public:
+    /**
+     * Starts the worker threads.
+     *
+     * @param threadCount number of workers; 0 uses the number of hardware threads
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    size_t size();
+
+    /**
+     * Queues a task to run on one of the workers.
+     *
+     * @param task callable taking no arguments
+     * @return a future holding the task's result (or the exception it threw)
+     */
+    template<typename Task>
+    auto enqueue(Task&& task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<Task>(task));
+        std::future<Result> result = packaged->get_future();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace([packaged]() { (*packaged)(); });
+        }
+
+        m_condition.notify_one();
+
+        return result;
+    }
+private:
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+
+    void workerLoop();
+};
+
+#endif // THREAD_POOL_HXX
@@ -7,6 +7,9 @@
 
 #include "VulkanWindow.hxx"
 
+// Storage for the dynamic dispatcher that every vulkan.hpp call in the rendering library goes through.
+VULKAN_HPP_DEFAULT_DISPATCH_LOADER_DYNAMIC_STORAGE
+
 // ----- Public Methods -----
 
 VulkanWindow::VulkanWindow(const uint32_t width, const uint32_t height, const std::string title) {
@@ -34,6 +37,15 @@ VulkanWindow::VulkanWindow(const uint32_t width, const uint32_t height, const st
 };
 
 VulkanWindow::~VulkanWindow() {
+    // Work may still be in flight on any of the queues
+    m_logicalDevice.waitIdle();
+
+    delete m_textures;
+    delete m_workers;
+
+    m_logicalDevice.destroyDescriptorPool(m_descriptorPool);
+    m_logicalDevice.destroyDescriptorSetLayout(m_descriptorSetLayout);
+
     m_logicalDevice.destroySemaphore(m_renderFinishedSemaphore);
     m_logicalDevice.destroySemaphore(m_imgAvailableSemaphore);
 
@@ -55,8 +67,14 @@ VulkanWindow::~VulkanWindow() {
     }
 
     m_logicalDevice.destroySwapchainKHR(m_swapChain);
+
+    delete m_transferSubmitter;
+    delete m_computeSubmitter;
+    delete m_graphicsSubmitter;
+
     m_logicalDevice.destroy();
     m_instance.destroySurfaceKHR(m_surface);
+    DebugUtils::destroyMessenger(m_instance);
     m_instance.destroy();
 
     glfwDestroyWindow(m_window);
@@ -68,37 +86,98 @@ GLFWwindow *VulkanWindow::window() {
     return m_window;
 }
 
+vk::PhysicalDevice VulkanWindow::physicalDevice() {
+    return m_device;
+}
+
 vk::Device *VulkanWindow::logicalDevice() {
     return &m_logicalDevice;
 }
 
-void VulkanWindow::drawFrame() {
+QueueSubmitter *VulkanWindow::graphicsSubmitter() {
+    return m_graphicsSubmitter;
+}
+
+QueueSubmitter *VulkanWindow::computeSubmitter() {
+    return m_computeSubmitter;
+}
+
+QueueSubmitter *VulkanWindow::transferSubmitter() {
+    return m_transferSubmitter;
+}
+
+ThreadPool *VulkanWindow::workers() {
+    return m_workers;
+}
+
+TextureStreamer *VulkanWindow::textures() {
+    return m_textures;
+}
+
+uint32_t VulkanWindow::width() {
+    return m_width;
+}
+
+uint32_t VulkanWindow::height() {
+    return m_height;
+}
+
+void VulkanWindow::setClearColor(const std::array<float, 4>& color) {
+    if (color == m_clearColor) {
+        return;
+    }
+
+    m_clearColor = color;
+    m_staleCommandBuffers.assign(m_commandBuffers.size(), true);
+}
+
+uint64_t VulkanWindow::drawFrame() {
+    // The semaphores and command buffers are reused, so the previous frame has to be done with them.
+    m_graphicsSubmitter->wait(m_graphicsSubmitter->lastSubmitted());
+
+    // Texture streaming is pumped once per frame from the thread that submits
+    m_textures->update(++m_frameNumber);
+    updateTextureDescriptor();
+
     // Determine which image can be drawn to.
     uint32_t imgIndex;
     m_logicalDevice.acquireNextImageKHR(m_swapChain, UINT64_MAX,
          m_imgAvailableSemaphore, nullptr, &imgIndex);
 
-    // Set up the draw command buffer
-    vk::Semaphore waitSemaphores[] = {m_imgAvailableSemaphore};
-    vk::PipelineStageFlags waitStages[] = {vk::PipelineStageFlagBits::eColorAttachmentOutput};
-    vk::Semaphore signalSemaphores[] = {m_renderFinishedSemaphore};
+    // Safe to re-record: the wait above means the GPU is done with every command buffer
+    if (m_staleCommandBuffers[imgIndex]) {
+        recordCommandBuffer(imgIndex);
+        m_staleCommandBuffers[imgIndex] = false;
+    }
 
-    vk::SubmitInfo submitInfo(1, waitSemaphores, waitStages, 1, &m_commandBuffers[imgIndex],
-        1, signalSemaphores);
+    // Wait for the swap chain image, plus any uploads and compute work queued since the last frame.
+    // Neither of those queues waits on graphics, so they run alongside the previous frame.
+    std::vector<SubmitWait> waits = {
+        {m_imgAvailableSemaphore, 0, vk::PipelineStageFlagBits::eColorAttachmentOutput}
+    };
 
-    // Submit draw command buffer
-    try {
-        m_graphicsQueue.submit(1, &submitInfo, nullptr);
-    } catch (const std::system_error& e) {
-        std::cerr << "Failed to submit draw command buffer." << std::endl;
-        throw std::runtime_error(e.what());
+    for (const auto& wait : m_transferSubmitter->waitForLatest(vk::PipelineStageFlagBits::eVertexInput |
+            vk::PipelineStageFlagBits::eFragmentShader)) {
+        waits.push_back(wait);
+    }
+
+    for (const auto& wait : m_computeSubmitter->waitForLatest(vk::PipelineStageFlagBits::eDrawIndirect |
+            vk::PipelineStageFlagBits::eVertexInput)) {
+        waits.push_back(wait);
     }
 
+    vk::Semaphore signalSemaphores[] = {m_renderFinishedSemaphore};
+
+    // Submit draw command buffer
+    uint64_t frameValue = m_graphicsSubmitter->submit({m_commandBuffers[imgIndex]}, waits, {m_renderFinishedSemaphore});
+
     vk::SwapchainKHR swapchains[] = {m_swapChain};
 
     vk::PresentInfoKHR presentInfo(1, signalSemaphores, 1, swapchains, &imgIndex, nullptr);
 
     m_presentQueue.presentKHR(&presentInfo);
+
+    return frameValue;
 }
 
 // ----- Private Methods -----
@@ -120,24 +199,50 @@ void VulkanWindow::initVulkan() {
     createLogicalDevice();
     createSwapChain();
     createImageViews();
-    m_render = new Render(&m_logicalDevice, m_swapChainImageFormat);
-    m_gPipeline = new GraphicsPipeline(&m_logicalDevice, &m_swapChainExtent, m_render->renderPass());
-    createFrameBuffers();
+    createDescriptorSetLayout();
+    TriangleShader::VertexSpecialization vertConstants(TRIANGLE_SCALE);
+    TriangleShader::FragmentSpecialization fragConstants(TRIANGLE_GRAYSCALE, TRIANGLE_POSTERIZE_LEVELS);
+
+#ifdef VK_KHR_dynamic_rendering
+    if (m_dynamicRendering) {
+        // Rendering begins directly on the swapchain image views; no render pass or framebuffers
+        m_gPipeline = new GraphicsPipeline(&m_logicalDevice, &m_swapChainExtent, m_swapChainImageFormat,
+            &m_descriptorSetLayout, vertConstants.info(), fragConstants.info());
+    }
+#endif // VK_KHR_dynamic_rendering
+
+    if (!m_dynamicRendering) {
+        m_render = new Render(&m_logicalDevice, m_swapChainImageFormat);
+        m_gPipeline = new GraphicsPipeline(&m_logicalDevice, &m_swapChainExtent, m_render->renderPass(),
+            &m_descriptorSetLayout, vertConstants.info(), fragConstants.info());
+        createFrameBuffers();
+    }
+
     createCommandPool();
+    createDescriptorSet();
     createCommandBuffers();
     createSemaphores();
+    nameObjects();
+
+    m_workers = new ThreadPool();
+    m_textures = new TextureStreamer(m_device, &m_logicalDevice, m_transferSubmitter, m_graphicsSubmitter,
+        m_workers, TEXTURE_RESIDENCY_BUDGET, TEXTURE_STAGING_SIZE);
+    m_triangleTexture = m_textures->request(TRIANGLE_TEXTURE);
     std::cout << "I'm just curious..." << std::endl;
 }
 
 // ----- Vulkan-specific methods -----
 
 void VulkanWindow::createVkInstance() {
+    // Only the global entry point comes from the loader; everything else is looked up from it.
+    VULKAN_HPP_DEFAULT_DISPATCHER.init(vkGetInstanceProcAddr);
+
     if (ENABLE_VALIDATION_LAYERS && !checkValidationLayerSupport()) {
         throw std::runtime_error("Validation layers requested, but not available!");
     }
 
     vk::ApplicationInfo info("Vulkan Triangle", VK_MAKE_VERSION(1, 0, 0),
-        "No Engine", VK_MAKE_VERSION(1, 0, 0), VK_API_VERSION_1_1);
+        "No Engine", VK_MAKE_VERSION(1, 0, 0), VK_API_VERSION_1_2);
 
 
     vk::InstanceCreateInfo create({}, &info);
@@ -155,11 +260,24 @@ void VulkanWindow::createVkInstance() {
 
     glfwExtensions = glfwGetRequiredInstanceExtensions(&glfwExtCount);
 
-    create.enabledExtensionCount = glfwExtCount;
-    create.ppEnabledExtensionNames = glfwExtensions;
+    std::vector<const char*> extensions(glfwExtensions, glfwExtensions + glfwExtCount);
+    DebugUtils::addInstanceExtension(extensions);
+
+    create.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    create.ppEnabledExtensionNames = extensions.data();
+
+    // Chaining the messenger settings also reports problems in vkCreateInstance/vkDestroyInstance
+    VkDebugUtilsMessengerCreateInfoEXT messengerInfo = DebugUtils::messengerCreateInfo();
+    if (DebugUtils::enabled()) {
+        create.pNext = &messengerInfo;
+    }
     
     vk::createInstance(&create, nullptr, &m_instance);
 
+    VULKAN_HPP_DEFAULT_DISPATCHER.init(m_instance);
+
+    DebugUtils::createMessenger(m_instance);
+
     // getSupportedExtensions(true);
 }
 
@@ -169,6 +287,45 @@ void VulkanWindow::createSurface() {
     }
 }
 
+void VulkanWindow::nameObjects() {
+    DebugUtils::setName(m_logicalDevice, m_logicalDevice, "device");
+    DebugUtils::setName(m_logicalDevice, m_surface, "window surface");
+    DebugUtils::setName(m_logicalDevice, m_presentQueue, "present queue");
+    DebugUtils::setName(m_logicalDevice, m_swapChain, "swapchain");
+
+    for (size_t i = 0; i < m_swapChainImages.size(); i++) {
+        DebugUtils::setName(m_logicalDevice, m_swapChainImages[i], "swapchain image", i);
+        DebugUtils::setName(m_logicalDevice, m_swapChainImageViews[i], "swapchain image view", i);
+    }
+
+    for (size_t i = 0; i < m_frameBuffers.size(); i++) {
+        DebugUtils::setName(m_logicalDevice, *m_frameBuffers[i]->buffer(), "framebuffer", i);
+    }
+
+    DebugUtils::setName(m_logicalDevice, m_commandPool, "frame command pool");
+    for (size_t i = 0; i < m_commandBuffers.size(); i++) {
+        DebugUtils::setName(m_logicalDevice, m_commandBuffers[i], "frame commands", i);
+    }
+
+    DebugUtils::setName(m_logicalDevice, m_descriptorSetLayout, "triangle set layout");
+    DebugUtils::setName(m_logicalDevice, m_descriptorPool, "triangle descriptor pool");
+    DebugUtils::setName(m_logicalDevice, m_descriptorSet, "triangle descriptor set");
+
+    DebugUtils::setName(m_logicalDevice, m_imgAvailableSemaphore, "image available");
+    DebugUtils::setName(m_logicalDevice, m_renderFinishedSemaphore, "render finished");
+
+    // Queues can share a family, in which case the last name given wins
+    DebugUtils::setName(m_logicalDevice, *m_graphicsSubmitter->queue(), "graphics queue");
+    DebugUtils::setName(m_logicalDevice, *m_graphicsSubmitter->timeline(), "graphics timeline");
+    DebugUtils::setName(m_logicalDevice, *m_graphicsSubmitter->commandPool(), "graphics transient pool");
+    DebugUtils::setName(m_logicalDevice, *m_computeSubmitter->queue(), "compute queue");
+    DebugUtils::setName(m_logicalDevice, *m_computeSubmitter->timeline(), "compute timeline");
+    DebugUtils::setName(m_logicalDevice, *m_computeSubmitter->commandPool(), "compute transient pool");
+    DebugUtils::setName(m_logicalDevice, *m_transferSubmitter->queue(), "transfer queue");
+    DebugUtils::setName(m_logicalDevice, *m_transferSubmitter->timeline(), "transfer timeline");
+    DebugUtils::setName(m_logicalDevice, *m_transferSubmitter->commandPool(), "transfer transient pool");
+}
+
 void VulkanWindow::createImageViews() {
     m_swapChainImageViews.resize(m_swapChainImages.size());
 
@@ -207,7 +364,9 @@ void VulkanWindow::createFrameBuffers() {
 void VulkanWindow::createCommandPool() {
     QueueFamilyIndices queueFamilyIndices = findQueueFamilies(m_device);
 
-    vk::CommandPoolCreateInfo poolInfo({}, queueFamilyIndices.graphicsFamily.value());
+    // Command buffers are re-recorded individually when the clear color changes
+    vk::CommandPoolCreateInfo poolInfo(vk::CommandPoolCreateFlagBits::eResetCommandBuffer,
+        queueFamilyIndices.graphicsFamily.value());
 
     try {
         m_logicalDevice.createCommandPool(&poolInfo, nullptr, &m_commandPool);
@@ -218,7 +377,7 @@ void VulkanWindow::createCommandPool() {
 }
 
 void VulkanWindow::createCommandBuffers() {
-    m_commandBuffers.resize(m_frameBuffers.size());
+    m_commandBuffers.resize(m_swapChainImageViews.size());
 
     vk::CommandBufferAllocateInfo allocateInfo(m_commandPool, vk::CommandBufferLevel::ePrimary,
                                                (uint32_t)m_commandBuffers.size());
@@ -230,43 +389,167 @@ void VulkanWindow::createCommandBuffers() {
         throw std::runtime_error(e.what());
     }
 
-    // Set up command buffer recording
-    vk::ClearColorValue clearColorValue(std::array<float, 4>{0.0f, 0.0f, 0.0f, 1.0f});
-    vk::ClearValue clearColor(clearColorValue);
+    m_staleCommandBuffers.assign(m_commandBuffers.size(), false);
+
     for (size_t i = 0; i < m_commandBuffers.size(); i++) {
-        vk::CommandBufferBeginInfo beginInfo;
+        recordCommandBuffer(i);
+    }
+}
 
-        try {
-            m_commandBuffers[i].begin(&beginInfo);
-        } catch (const std::system_error& e) {
-            std::cerr << "Failed to set up command buffer " << i << std::endl;
-            throw std::runtime_error(e.what());
-        }
+void VulkanWindow::recordCommandBuffer(size_t imageIndex) {
+    vk::ClearColorValue clearColorValue(m_clearColor);
+    vk::ClearValue clearColor(clearColorValue);
+
+    // Set up command buffer recording
+    vk::CommandBufferBeginInfo beginInfo;
+
+    try {
+        m_commandBuffers[imageIndex].begin(&beginInfo);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to set up command buffer " << imageIndex << std::endl;
+        throw std::runtime_error(e.what());
+    }
 
+    DebugUtils::beginLabel(m_commandBuffers[imageIndex], "triangle pass", {0.2f, 0.6f, 1.0f, 1.0f});
+
+    if (m_dynamicRendering) {
+        beginDynamicRendering(m_commandBuffers[imageIndex], imageIndex, clearColor);
+    } else {
         // Directly write our render passes here
-        vk::RenderPassBeginInfo renderPassInfo(*m_render->renderPass(), *m_frameBuffers[i]->buffer(), {}, 1, &clearColor);
+        vk::RenderPassBeginInfo renderPassInfo(*m_render->renderPass(), *m_frameBuffers[imageIndex]->buffer(), {}, 1, &clearColor);
 
         renderPassInfo.renderArea.offset = vk::Offset2D(0, 0);
         renderPassInfo.renderArea.extent = m_swapChainExtent;
 
-        m_commandBuffers[i].beginRenderPass(&renderPassInfo, vk::SubpassContents::eInline);
+        m_commandBuffers[imageIndex].beginRenderPass(&renderPassInfo, vk::SubpassContents::eInline);
+    }
 
+    // Until the texture has streamed in the frame is only cleared
+    if (m_boundTextureView) {
         // Bind to the graphics pipeline
-        m_commandBuffers[i].bindPipeline(vk::PipelineBindPoint::eGraphics, *m_gPipeline->pipeline());
+        m_commandBuffers[imageIndex].bindPipeline(vk::PipelineBindPoint::eGraphics, *m_gPipeline->pipeline());
+        m_commandBuffers[imageIndex].bindDescriptorSets(vk::PipelineBindPoint::eGraphics, *m_gPipeline->layout(),
+            0, m_descriptorSet, nullptr);
 
         // Set up draw command
-        m_commandBuffers[i].draw(3, 1, 0, 0);
+        m_commandBuffers[imageIndex].draw(3, 1, 0, 0);
+    }
 
-        // End the render pass
-        m_commandBuffers[i].endRenderPass();
+    // End the render pass
+    if (m_dynamicRendering) {
+        endDynamicRendering(m_commandBuffers[imageIndex], imageIndex);
+    } else {
+        m_commandBuffers[imageIndex].endRenderPass();
+    }
 
-        try {
-            m_commandBuffers[i].end();
-        } catch (const std::system_error& e) {
-            std::cerr << "Failed to record command buffer." << std::endl;
-            throw std::runtime_error(e.what());
+    DebugUtils::endLabel(m_commandBuffers[imageIndex]);
+
+    try {
+        m_commandBuffers[imageIndex].end();
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to record command buffer." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+}
+
+void VulkanWindow::createDescriptorSetLayout() {
+    vk::DescriptorSetLayoutBinding textureBinding(0, vk::DescriptorType::eCombinedImageSampler, 1,
+        vk::ShaderStageFlagBits::eFragment);
+    vk::DescriptorSetLayoutCreateInfo layoutInfo({}, 1, &textureBinding);
+
+    try {
+        m_descriptorSetLayout = m_logicalDevice.createDescriptorSetLayout(layoutInfo);
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to create descriptor set layout." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+}
+
+void VulkanWindow::createDescriptorSet() {
+    vk::DescriptorPoolSize poolSize(vk::DescriptorType::eCombinedImageSampler, 1);
+    vk::DescriptorPoolCreateInfo poolInfo({}, 1, 1, &poolSize);
+
+    try {
+        m_descriptorPool = m_logicalDevice.createDescriptorPool(poolInfo);
+
+        vk::DescriptorSetAllocateInfo allocateInfo(m_descriptorPool, 1, &m_descriptorSetLayout);
+        m_descriptorSet = m_logicalDevice.allocateDescriptorSets(allocateInfo)[0];
+    } catch (const std::system_error& e) {
+        std::cerr << "Failed to create the triangle descriptor set." << std::endl;
+        throw std::runtime_error(e.what());
+    }
+}
+
+void VulkanWindow::updateTextureDescriptor() {
+    // Also marks the texture as used, which keeps it from being evicted
+    vk::ImageView *view = m_textures->view(m_triangleTexture);
+
+    if (view == nullptr) {
+        // Evicted: stop drawing through the old view before the streamer destroys it
+        if (m_boundTextureView) {
+            m_boundTextureView = nullptr;
+            m_staleCommandBuffers.assign(m_commandBuffers.size(), true);
         }
+
+        return;
     }
+
+    if (*view == m_boundTextureView) {
+        return;
+    }
+
+    vk::DescriptorImageInfo imageInfo(*m_textures->sampler(), *view, vk::ImageLayout::eShaderReadOnlyOptimal);
+    vk::WriteDescriptorSet write(m_descriptorSet, 0, 0, 1, vk::DescriptorType::eCombinedImageSampler, &imageInfo);
+    m_logicalDevice.updateDescriptorSets(write, nullptr);
+
+    m_boundTextureView = *view;
+    m_staleCommandBuffers.assign(m_commandBuffers.size(), true);
+}
+
+void VulkanWindow::beginDynamicRendering(vk::CommandBuffer commandBuffer, size_t imageIndex,
+    const vk::ClearValue& clearColor) {
+#ifdef VK_KHR_dynamic_rendering
+    vk::ImageSubresourceRange colorRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1);
+
+    // Same dependency the render pass declares: the image is written once the acquire semaphore,
+    // waited on at the color attachment output stage, has signaled. Its old contents are discarded.
+    vk::ImageMemoryBarrier toAttachment({}, vk::AccessFlagBits::eColorAttachmentWrite,
+        vk::ImageLayout::eUndefined, vk::ImageLayout::eColorAttachmentOptimal,
+        VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, m_swapChainImages[imageIndex], colorRange);
+
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput,
+        vk::PipelineStageFlagBits::eColorAttachmentOutput, {}, 0, nullptr, 0, nullptr, 1, &toAttachment);
+
+    vk::RenderingAttachmentInfoKHR colorAttachment(m_swapChainImageViews[imageIndex],
+        vk::ImageLayout::eColorAttachmentOptimal, vk::ResolveModeFlagBits::eNone, nullptr,
+        vk::ImageLayout::eUndefined, vk::AttachmentLoadOp::eClear, vk::AttachmentStoreOp::eStore, clearColor);
+
+    vk::RenderingInfoKHR renderingInfo({}, vk::Rect2D(vk::Offset2D(0, 0), m_swapChainExtent), 1, 0, 1, &colorAttachment);
+
+    commandBuffer.beginRenderingKHR(&renderingInfo);
+#else
+    (void) commandBuffer;
+    (void) imageIndex;
+    (void) clearColor;
+#endif // VK_KHR_dynamic_rendering
+}
+
+void VulkanWindow::endDynamicRendering(vk::CommandBuffer commandBuffer, size_t imageIndex) {
+#ifdef VK_KHR_dynamic_rendering
+    commandBuffer.endRenderingKHR();
+
+    // Hand the image to presentation; the present waits on the render finished semaphore
+    vk::ImageSubresourceRange colorRange(vk::ImageAspectFlagBits::eColor, 0, 1, 0, 1);
+    vk::ImageMemoryBarrier toPresent(vk::AccessFlagBits::eColorAttachmentWrite, {},
+        vk::ImageLayout::eColorAttachmentOptimal, vk::ImageLayout::ePresentSrcKHR,
+        VK_QUEUE_FAMILY_IGNORED, VK_QUEUE_FAMILY_IGNORED, m_swapChainImages[imageIndex], colorRange);
+
+    commandBuffer.pipelineBarrier(vk::PipelineStageFlagBits::eColorAttachmentOutput,
+        vk::PipelineStageFlagBits::eBottomOfPipe, {}, 0, nullptr, 0, nullptr, 1, &toPresent);
+#else
+    (void) commandBuffer;
+    (void) imageIndex;
+#endif // VK_KHR_dynamic_rendering
 }
 
 void VulkanWindow::createSemaphores() {
@@ -283,10 +566,10 @@ void VulkanWindow::createSemaphores() {
 
 bool VulkanWindow::checkValidationLayerSupport() {
     uint32_t layerCount;
-    vk::enumerateInstanceLayerProperties(&layerCount, {}, {});
+    vk::enumerateInstanceLayerProperties(&layerCount, nullptr);
 
     std::vector<vk::LayerProperties> availableLayers(layerCount);
-    vk::enumerateInstanceLayerProperties(&layerCount, availableLayers.data(), {});
+    vk::enumerateInstanceLayerProperties(&layerCount, availableLayers.data());
 
     for (const std::string layerName : VALIDATION_LAYERS) {
         bool layerFound = false;
@@ -308,10 +591,10 @@ bool VulkanWindow::checkValidationLayerSupport() {
 
 std::vector<vk::ExtensionProperties> VulkanWindow::getSupportedExtensions(bool printResults) {
     uint32_t extCount = 0;
-    vk::enumerateInstanceExtensionProperties({}, &extCount, {}, {});
+    vk::enumerateInstanceExtensionProperties({}, &extCount, nullptr);
 
     std::vector<vk::ExtensionProperties> extensions(extCount);
-    vk::enumerateInstanceExtensionProperties({}, &extCount, extensions.data(), {});
+    vk::enumerateInstanceExtensionProperties({}, &extCount, extensions.data());
 
     if (printResults) {
         std::clog << "Available extensions:" << std::endl;
@@ -326,10 +609,10 @@ std::vector<vk::ExtensionProperties> VulkanWindow::getSupportedExtensions(bool p
 
 bool VulkanWindow::checkDeviceExtensionSupport(vk::PhysicalDevice device) {
     uint32_t extCount = 0;
-    device.enumerateDeviceExtensionProperties({}, &extCount, {}, {});
+    device.enumerateDeviceExtensionProperties({}, &extCount, nullptr);
 
     std::vector<vk::ExtensionProperties> availableExtensions(extCount);
-    device.enumerateDeviceExtensionProperties({}, &extCount, availableExtensions.data(), {});
+    device.enumerateDeviceExtensionProperties({}, &extCount, availableExtensions.data());
 
     std::set<std::string> requiredExts(DEVICE_EXTENSIONS.begin(), DEVICE_EXTENSIONS.end());
 
@@ -340,16 +623,39 @@ bool VulkanWindow::checkDeviceExtensionSupport(vk::PhysicalDevice device) {
     return requiredExts.empty();
 }
 
+bool VulkanWindow::checkDynamicRenderingSupport(vk::PhysicalDevice device) {
+#ifdef VK_KHR_dynamic_rendering
+    bool extensionFound = false;
+
+    for (const auto& extension : device.enumerateDeviceExtensionProperties()) {
+        if (std::string(extension.extensionName) == VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME) {
+            extensionFound = true;
+            break;
+        }
+    }
+
+    if (!extensionFound) {
+        return false;
+    }
+
+    auto featureChain = device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceDynamicRenderingFeaturesKHR>();
+    return featureChain.get<vk::PhysicalDeviceDynamicRenderingFeaturesKHR>().dynamicRendering;
+#else
+    (void) device;
+    return false;
+#endif // VK_KHR_dynamic_rendering
+}
+
 void VulkanWindow::pickPhysicalDevice() {
     uint32_t deviceCount = 0;
-    m_instance.enumeratePhysicalDevices(&deviceCount, {}, {});
+    m_instance.enumeratePhysicalDevices(&deviceCount, nullptr);
 
     if (deviceCount == 0) {
         throw std::runtime_error("Failed to find any devices with Vulkan support!");
     }
 
     std::vector<vk::PhysicalDevice> devices(deviceCount);
-    m_instance.enumeratePhysicalDevices(&deviceCount, devices.data(), {});
+    m_instance.enumeratePhysicalDevices(&deviceCount, devices.data());
 
     for (const auto& device : devices) {
         if (isDeviceSuitable(device)) {
@@ -366,6 +672,14 @@ bool VulkanWindow::isDeviceSuitable(vk::PhysicalDevice device) {
     vk::PhysicalDeviceFeatures deviceFeatures;
     deviceFeatures = device.getFeatures();
 
+    // Timeline semaphores are core in Vulkan 1.2
+    if (deviceProps.apiVersion < VK_API_VERSION_1_2) {
+        return false;
+    }
+
+    auto featureChain = device.getFeatures2<vk::PhysicalDeviceFeatures2, vk::PhysicalDeviceTimelineSemaphoreFeatures>();
+    bool timelineSupported = featureChain.get<vk::PhysicalDeviceTimelineSemaphoreFeatures>().timelineSemaphore;
+
     QueueFamilyIndices indices = findQueueFamilies(device);
     bool extensionsSupported = checkDeviceExtensionSupport(device);
 
@@ -376,39 +690,59 @@ bool VulkanWindow::isDeviceSuitable(vk::PhysicalDevice device) {
     }
 
     return deviceFeatures.geometryShader && indices.isComplete() && extensionsSupported
-        && swapChainAdequate;
+        && swapChainAdequate && timelineSupported;
 }
 
 QueueFamilyIndices VulkanWindow::findQueueFamilies(vk::PhysicalDevice device) {
     QueueFamilyIndices indices;
 
     uint32_t queueFamilyCount = 0;
-    device.getQueueFamilyProperties(&queueFamilyCount, {}, {});
+    device.getQueueFamilyProperties(&queueFamilyCount, nullptr);
 
     std::vector<vk::QueueFamilyProperties> queueFamilies(queueFamilyCount);
-    device.getQueueFamilyProperties(&queueFamilyCount, queueFamilies.data(), {});
+    device.getQueueFamilyProperties(&queueFamilyCount, queueFamilies.data());
 
     uint32_t i = 0;
     for (const auto& family : queueFamilies) {
         vk::Bool32 presentSupport = false;
         vkGetPhysicalDeviceSurfaceSupportKHR(device, i, m_surface, &presentSupport);
-        device.getSurfaceSupportKHR(i, m_surface, &presentSupport, {});
+        device.getSurfaceSupportKHR(i, m_surface, &presentSupport);
+
+        bool hasGraphics = static_cast<bool>(family.queueFlags & vk::QueueFlagBits::eGraphics);
+        bool hasCompute = static_cast<bool>(family.queueFlags & vk::QueueFlagBits::eCompute);
+        bool hasTransfer = static_cast<bool>(family.queueFlags & vk::QueueFlagBits::eTransfer);
 
-        if (family.queueCount > 0 && family.queueFlags & vk::QueueFlagBits::eGraphics) {
+        if (family.queueCount > 0 && hasGraphics && !indices.graphicsFamily.has_value()) {
             indices.graphicsFamily = i;
         }
 
-        if (family.queueCount > 0 && presentSupport) {
+        if (family.queueCount > 0 && presentSupport && !indices.presentFamily.has_value()) {
             indices.presentFamily = i;
         }
 
-        if (indices.isComplete()) {
-            break;
+        // Async compute: a compute family without graphics
+        if (family.queueCount > 0 && hasCompute && !hasGraphics && !indices.computeFamily.has_value()) {
+            indices.computeFamily = i;
+        }
+
+        // Dedicated transfer (DMA) family: transfer without graphics or compute. These may report a
+        // (0,0,0) image transfer granularity, which still allows the whole-level copies streaming uses.
+        if (family.queueCount > 0 && hasTransfer && !hasGraphics && !hasCompute && !indices.transferFamily.has_value()) {
+            indices.transferFamily = i;
         }
 
         i++;
     }
 
+    // Every graphics family also supports compute and transfer, so it is always a valid fallback.
+    if (!indices.computeFamily.has_value()) {
+        indices.computeFamily = indices.graphicsFamily;
+    }
+
+    if (!indices.transferFamily.has_value()) {
+        indices.transferFamily = indices.graphicsFamily;
+    }
+
     return indices;
 }
 
@@ -419,7 +753,9 @@ void VulkanWindow::createLogicalDevice() {
     std::vector<vk::DeviceQueueCreateInfo> queueCreateInfos;
     std::set<uint32_t> uniqueQueueFamilies = {
         indices.graphicsFamily.value(),
-        indices.presentFamily.value()
+        indices.presentFamily.value(),
+        indices.computeFamily.value(),
+        indices.transferFamily.value()
     };
 
     float queuePriority = 1.0f;
@@ -439,8 +775,25 @@ void VulkanWindow::createLogicalDevice() {
 
     createInfo.pEnabledFeatures = &deviceFeatures;
 
-    createInfo.enabledExtensionCount = static_cast<uint32_t>(DEVICE_EXTENSIONS.size());
-    createInfo.ppEnabledExtensionNames = DEVICE_EXTENSIONS.data();
+    // Timeline semaphores synchronize the graphics, compute and transfer queues
+    vk::PhysicalDeviceTimelineSemaphoreFeatures timelineFeatures(true);
+    createInfo.pNext = &timelineFeatures;
+
+    std::vector<const char*> extensions = DEVICE_EXTENSIONS;
+
+#ifdef VK_KHR_dynamic_rendering
+    // Optional: falls back to the render pass and framebuffers when unsupported
+    vk::PhysicalDeviceDynamicRenderingFeaturesKHR dynamicRenderingFeatures(true);
+    m_dynamicRendering = PREFER_DYNAMIC_RENDERING && checkDynamicRenderingSupport(m_device);
+
+    if (m_dynamicRendering) {
+        extensions.push_back(VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME);
+        timelineFeatures.pNext = &dynamicRenderingFeatures;
+    }
+#endif // VK_KHR_dynamic_rendering
+
+    createInfo.enabledExtensionCount = static_cast<uint32_t>(extensions.size());
+    createInfo.ppEnabledExtensionNames = extensions.data();
 
     if (ENABLE_VALIDATION_LAYERS) {
         createInfo.enabledLayerCount = static_cast<uint32_t>(VALIDATION_LAYERS.size());
@@ -450,10 +803,17 @@ void VulkanWindow::createLogicalDevice() {
     }
 
     try {
-        m_device.createDevice(&createInfo, {}, &m_logicalDevice, {});
+        m_device.createDevice(&createInfo, {}, &m_logicalDevice);
+
+        // Resolve device functions through vkGetDeviceProcAddr so that queue and vkCmd* calls go
+        // straight to the driver instead of through the loader's trampolines.
+        VULKAN_HPP_DEFAULT_DISPATCHER.init(m_logicalDevice);
+
+        m_logicalDevice.getQueue(indices.presentFamily.value(), 0, &m_presentQueue);
 
-        m_logicalDevice.getQueue(indices.presentFamily.value(), 0, &m_presentQueue, {});
-        m_logicalDevice.getQueue(indices.graphicsFamily.value(), 0, &m_graphicsQueue, {});
+        m_graphicsSubmitter = new QueueSubmitter(&m_logicalDevice, indices.graphicsFamily.value(), 0);
+        m_computeSubmitter = new QueueSubmitter(&m_logicalDevice, indices.computeFamily.value(), 0);
+        m_transferSubmitter = new QueueSubmitter(&m_logicalDevice, indices.transferFamily.value(), 0);
     } catch (std::system_error e) {
         std::cerr << "Failed to create a logical Vulkan device." << std::endl;
         std::cerr << e.what() << std::endl;
@@ -500,16 +860,16 @@ void VulkanWindow::createSwapChain() {
     createInfo.clipped = true;
 
     try {
-        m_logicalDevice.createSwapchainKHR(&createInfo, {}, &m_swapChain, {});
+        m_logicalDevice.createSwapchainKHR(&createInfo, {}, &m_swapChain);
     } catch (std::system_error e) {
         std::cerr << "Failed to create swapchain." <<std::endl;
         throw std::runtime_error(e.what());
     }
 
     // Retrieve the swap chain images
-    m_logicalDevice.getSwapchainImagesKHR(m_swapChain, &imageCount, {}, {});
+    m_logicalDevice.getSwapchainImagesKHR(m_swapChain, &imageCount, nullptr);
     m_swapChainImages.resize(imageCount);
-    m_logicalDevice.getSwapchainImagesKHR(m_swapChain, &imageCount, m_swapChainImages.data(), {});
+    m_logicalDevice.getSwapchainImagesKHR(m_swapChain, &imageCount, m_swapChainImages.data());
 
     m_swapChainImageFormat = surfaceFormat.format;
     m_swapChainExtent = extent;
@@ -517,22 +877,22 @@ void VulkanWindow::createSwapChain() {
 
 SwapChainSupportDetails VulkanWindow::querySwapChainSupport(vk::PhysicalDevice device){
     SwapChainSupportDetails details;
-    device.getSurfaceCapabilitiesKHR(m_surface, &details.capabilites, {});
+    device.getSurfaceCapabilitiesKHR(m_surface, &details.capabilites);
 
     uint32_t formatCount;
-    device.getSurfaceFormatsKHR(m_surface, &formatCount, {}, {});
+    device.getSurfaceFormatsKHR(m_surface, &formatCount, nullptr);
 
     if (formatCount != 0) {
         details.formats.resize(formatCount);
-        device.getSurfaceFormatsKHR(m_surface, &formatCount, details.formats.data(), {});
+        device.getSurfaceFormatsKHR(m_surface, &formatCount, details.formats.data());
     }
 
     uint32_t presentModeCount;
-    device.getSurfacePresentModesKHR(m_surface, &presentModeCount, {}, {});
+    device.getSurfacePresentModesKHR(m_surface, &presentModeCount, nullptr);
 
     if (presentModeCount != 0) {
         details.presentModes.resize(presentModeCount);
-        device.getSurfacePresentModesKHR(m_surface, &presentModeCount, details.presentModes.data(), {});
+        device.getSurfacePresentModesKHR(m_surface, &presentModeCount, details.presentModes.data());
     }
 
     return details;
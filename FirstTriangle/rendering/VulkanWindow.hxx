@@ -6,6 +6,7 @@ extern "C" {
 #include <GLFW/glfw3.h>
 }
 
+#include <array>
 #include <iostream>
 #include <vector>
 #include <optional>
@@ -14,10 +15,25 @@ extern "C" {
 #include "Render.hxx"
 #include "GraphicsPipeline.hxx"
 #include "FrameBuffer.hxx"
+#include "QueueSubmitter.hxx"
+#include "ThreadPool.hxx"
+#include "TextureStreamer.hxx"
+#include "DebugUtils.hxx"
 
 static const uint32_t DEFAULT_WIDTH = 800;
 static const uint32_t DEFAULT_HEIGHT = 600;
 
+static const vk::DeviceSize TEXTURE_RESIDENCY_BUDGET = 256 * 1024 * 1024;
+static const vk::DeviceSize TEXTURE_STAGING_SIZE = 32 * 1024 * 1024;
+
+// Streamed in and sampled by the triangle; copied next to the binary by the build
+static const char *TRIANGLE_TEXTURE = "textures/checker.ppm";
+
+// Triangle pipeline variant, baked in through specialization constants
+static const float TRIANGLE_SCALE = 1.0f;
+static const bool TRIANGLE_GRAYSCALE = false;
+static const int32_t TRIANGLE_POSTERIZE_LEVELS = 0;
+
 const std::vector<const char*> VALIDATION_LAYERS = {
     "VK_LAYER_KHRONOS_validation"
 };
@@ -26,6 +42,9 @@ const std::vector<const char*> DEVICE_EXTENSIONS = {
     VK_KHR_SWAPCHAIN_EXTENSION_NAME
 };
 
+// Use VK_KHR_dynamic_rendering where the device supports it instead of a render pass and framebuffers
+static const bool PREFER_DYNAMIC_RENDERING = true;
+
 #ifdef NDEBUG
     static const bool ENABLE_VALIDATION_LAYERS = false;
 #else
@@ -35,6 +54,8 @@ const std::vector<const char*> DEVICE_EXTENSIONS = {
 struct QueueFamilyIndices {
     std::optional<uint32_t> graphicsFamily;
     std::optional<uint32_t> presentFamily;
+    std::optional<uint32_t> computeFamily;
+    std::optional<uint32_t> transferFamily;
 
     bool isComplete() {
         return graphicsFamily.has_value() && presentFamily.has_value();
@@ -53,8 +74,37 @@ public:
     ~VulkanWindow();
 
     GLFWwindow *window();
+    vk::PhysicalDevice physicalDevice();
     vk::Device *logicalDevice();
-    void drawFrame();
+    QueueSubmitter *graphicsSubmitter();
+
+    /**
+     * Submitter for async compute (e.g. culling). Frames wait on its latest submission before
+     * indirect draws and vertex input. Nothing submits to it yet.
+     */
+    QueueSubmitter *computeSubmitter();
+    QueueSubmitter *transferSubmitter();
+    ThreadPool *workers();
+    TextureStreamer *textures();
+    uint32_t width();
+    uint32_t height();
+
+    /**
+     * Changes the color the frame is cleared to. Command buffers are re-recorded as their swapchain
+     * image next comes up, so the change shows from the next drawFrame().
+     *
+     * Must be called from the thread that owns the device (see RenderThread).
+     */
+    void setClearColor(const std::array<float, 4>& color);
+
+    /**
+     * Submits the recorded commands for the next swapchain image and presents it.
+     *
+     * Must be called from the thread that owns the device (see RenderThread).
+     *
+     * @return graphics timeline value that signals once the frame's commands have executed
+     */
+    uint64_t drawFrame();
 private:
     // Window
     GLFWwindow *m_window;
@@ -70,8 +120,10 @@ private:
     vk::Device m_logicalDevice;
 
     // Queues
-    vk::Queue m_graphicsQueue;
     vk::Queue m_presentQueue;
+    QueueSubmitter *m_graphicsSubmitter;
+    QueueSubmitter *m_computeSubmitter;
+    QueueSubmitter *m_transferSubmitter;
 
     // Swap chain
     vk::SwapchainKHR m_swapChain;
@@ -81,10 +133,16 @@ private:
 
     // Graphics
     GraphicsPipeline *m_gPipeline;
-    Render *m_render;
+    bool m_dynamicRendering = false;
+
+    // Only used without dynamic rendering
+    Render *m_render = nullptr;
     std::vector<FrameBuffer*> m_frameBuffers;
     vk::CommandPool m_commandPool;
     std::vector<vk::CommandBuffer> m_commandBuffers;
+    // Command buffers recorded with an outdated clear color or texture descriptor
+    std::vector<bool> m_staleCommandBuffers;
+    std::array<float, 4> m_clearColor = {0.0f, 0.0f, 0.0f, 1.0f};
 
     // Image views
     std::vector<vk::ImageView> m_swapChainImageViews;
@@ -92,6 +150,18 @@ private:
     // Drawing
     vk::Semaphore m_imgAvailableSemaphore;
     vk::Semaphore m_renderFinishedSemaphore;
+    uint64_t m_frameNumber = 0;
+
+    // Assets
+    ThreadPool *m_workers;
+    TextureStreamer *m_textures;
+
+    // Triangle texture, bound through set 0 once its first mips are resident
+    TextureHandle m_triangleTexture;
+    vk::DescriptorSetLayout m_descriptorSetLayout;
+    vk::DescriptorPool m_descriptorPool;
+    vk::DescriptorSet m_descriptorSet;
+    vk::ImageView m_boundTextureView;
 
 
     // -----Instance management methods-----
@@ -135,8 +205,51 @@ private:
      */
     void createCommandBuffers();
 
+    /**
+     * Records the triangle pass for one swapchain image with the current clear color. The triangle
+     * itself is only drawn once its texture has been bound.
+     */
+    void recordCommandBuffer(size_t imageIndex);
+
     void createSemaphores();
 
+    /**
+     * Creates the layout of set 0: one combined image sampler for the fragment shader.
+     */
+    void createDescriptorSetLayout();
+
+    /**
+     * Allocates the descriptor set the triangle's texture is written to.
+     */
+    void createDescriptorSet();
+
+    /**
+     * Points the descriptor set at the newest view of the triangle's texture if it changed.
+     *
+     * Only safe while no submitted frame is still executing, since the set is not update-after-bind.
+     * Command buffers that bound the old contents are marked stale.
+     */
+    void updateTextureDescriptor();
+
+    /**
+     * Transitions the swapchain image for rendering and begins dynamic rendering on its view.
+     *
+     * @param commandBuffer command buffer being recorded
+     * @param imageIndex swapchain image the command buffer draws to
+     * @param clearColor color the image is cleared to
+     */
+    void beginDynamicRendering(vk::CommandBuffer commandBuffer, size_t imageIndex, const vk::ClearValue& clearColor);
+
+    /**
+     * Ends dynamic rendering and transitions the swapchain image for presentation.
+     */
+    void endDynamicRendering(vk::CommandBuffer commandBuffer, size_t imageIndex);
+
+    /**
+     * Gives the window's Vulkan objects debug names. Does nothing unless debug utils are enabled.
+     */
+    void nameObjects();
+
     /**
      * Checks if the required validation layers are present on the machine.
      * 
@@ -161,6 +274,14 @@ private:
      */
     bool checkDeviceExtensionSupport(vk::PhysicalDevice device);
 
+    /**
+     * Checks for VK_KHR_dynamic_rendering and its feature bit.
+     *
+     * @param device physical device to check
+     * @return false if unsupported or if the Vulkan headers predate the extension
+     */
+    bool checkDynamicRenderingSupport(vk::PhysicalDevice device);
+
     /**
      * Queries the Vulkan API for a list of graphics-capable devices on the host machine and selects the most appropriate one.
      */
@@ -176,6 +297,8 @@ private:
 
     /**
      * Determines which queue families are supported by the selected device.
+     *
+     * Compute and transfer prefer the first dedicated (async) family and fall back to the graphics family.
      * 
      * @param device physical device to check
      * @return a struct containing the indices of the queue families
@@ -1,10 +1,30 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+// Specialization constants, mirrored by TriangleShader in GraphicsPipeline.hxx.
+// Branches on these are resolved when the pipeline is compiled, not per fragment.
+layout(constant_id = 1) const bool GRAYSCALE = false;
+layout(constant_id = 2) const int POSTERIZE_LEVELS = 0;
+
+// Streamed by TextureStreamer; only the mips that are already resident are in the view
+layout(set = 0, binding = 0) uniform sampler2D triangleTexture;
+
 layout(location = 0) in vec3 fragColor;
+layout(location = 1) in vec2 fragTexCoord;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
-    outColor = vec4(fragColor, 1.0);
-}
\ No newline at end of file
+    vec3 color = fragColor * texture(triangleTexture, fragTexCoord).rgb;
+
+    if (GRAYSCALE) {
+        color = vec3(dot(color, vec3(0.2126, 0.7152, 0.0722)));
+    }
+
+    if (POSTERIZE_LEVELS > 1) {
+        float steps = float(POSTERIZE_LEVELS - 1);
+        color = floor(color * steps + 0.5) / steps;
+    }
+
+    outColor = vec4(color, 1.0);
+}
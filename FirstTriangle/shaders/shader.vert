@@ -1,6 +1,9 @@
 #version 450
 #extension GL_ARB_separate_shader_objects : enable
 
+// Specialization constants, mirrored by TriangleShader in GraphicsPipeline.hxx
+layout(constant_id = 0) const float SCALE = 1.0;
+
 vec2 positions[3] = vec2[] (
     vec2(0.0f, -0.5f),
     vec2(0.5f, 0.5f),
@@ -14,8 +17,11 @@ vec3 colors[3] = vec3[] (
 );
 
 layout(location = 0) out vec3 fragColor;
+layout(location = 1) out vec2 fragTexCoord;
 
 void main() {
-    gl_Position = vec4(positions[gl_VertexIndex], 0.0, 1.0);
+    gl_Position = vec4(positions[gl_VertexIndex] * SCALE, 0.0, 1.0);
     fragColor = colors[gl_VertexIndex];
-}
\ No newline at end of file
+    // The triangle spans [-0.5, 0.5] in both axes, which maps onto the whole texture
+    fragTexCoord = positions[gl_VertexIndex] + 0.5;
+}
@@ -1,40 +1,637 @@
-#define GLFW_INCLUDE_VULKAN
-#include <GLFW/glfw3.h>
-
-#define GLM_FORCE_RADIANS
-#define GLM_FORCE_DEPTH_ZERO_TO_ONE
-#include <glm/vec4.hpp>
-#include <glm/mat4x4.hpp>
+#include <vulkan/vulkan.h>
 
 #include <boost/format.hpp>
 
 #include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#ifndef BENCH_SHADER_PATH
+#define BENCH_SHADER_PATH "bench.comp.spv"
+#endif // BENCH_SHADER_PATH
+
+using Clock = std::chrono::steady_clock;
+
+// Workgroups dispatched per recorded command buffer, and bytes written per map/flush
+static const uint32_t RECORD_DISPATCHES = 16;
+static const VkDeviceSize MAP_SIZE = 64 * 1024;
+static const VkDeviceSize STORAGE_SIZE = 64 * 1024;
+
+struct Options {
+    int warmup = 3;
+    int repetitions = 10;
+    int deviceIndex = -1;
+    std::string filter;
+    std::string output;
+};
+
+/**
+ * One timed operation. `body` runs `iterations` times per repetition; `setup` and `teardown` run
+ * once around each repetition and are not timed.
+ */
+struct Benchmark {
+    std::string name;
+    size_t iterations;
+    std::function<void()> body;
+    std::function<void()> setup = []() {};
+    std::function<void()> teardown = []() {};
+};
+
+struct Result {
+    std::string name;
+    size_t iterations;
+    std::vector<double> samples; // nanoseconds per iteration, one per repetition
+};
+
+/**
+ * Everything the benchmarks share: a headless device with one compute queue and the objects the
+ * recording and submit benchmarks use.
+ */
+struct Context {
+    VkInstance instance = VK_NULL_HANDLE;
+    VkPhysicalDevice physicalDevice = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties properties;
+    uint32_t queueFamily = 0;
+    VkDevice device = VK_NULL_HANDLE;
+    VkQueue queue = VK_NULL_HANDLE;
+
+    VkCommandPool commandPool = VK_NULL_HANDLE;
+    VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+
+    std::vector<uint32_t> shaderCode;
+    VkShaderModule shaderModule = VK_NULL_HANDLE;
+    VkDescriptorSetLayout setLayout = VK_NULL_HANDLE;
+    VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+    VkPipeline pipeline = VK_NULL_HANDLE;
+    VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+    VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+    VkBuffer storageBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory storageMemory = VK_NULL_HANDLE;
+    VkBuffer hostBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory hostMemory = VK_NULL_HANDLE;
+};
+
+static void check(VkResult result, const char *what) {
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error(std::string(what) + " failed with VkResult " + std::to_string(result));
+    }
+}
+
+static std::vector<uint32_t> readSpirv(const std::string& filename) {
+    std::ifstream file(filename, std::ios::ate | std::ios::binary);
+
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open " + filename);
+    }
+
+    size_t size = static_cast<size_t>(file.tellg());
+    std::vector<uint32_t> code(size / sizeof(uint32_t));
+
+    file.seekg(0);
+    file.read(reinterpret_cast<char*>(code.data()), code.size() * sizeof(uint32_t));
+
+    return code;
+}
+
+// Instance/device setup mirrors FirstTriangle/bench/DispatchBench.cxx on purpose: VulkanTest is a
+// separate CMake project and only depends on the Vulkan SDK.
+static VkInstance createInstance() {
+    VkApplicationInfo appInfo = {VK_STRUCTURE_TYPE_APPLICATION_INFO};
+    appInfo.pApplicationName = "Vulkan Test";
+    appInfo.apiVersion = VK_API_VERSION_1_0;
+
+    VkInstanceCreateInfo createInfo = {VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO};
+    createInfo.pApplicationInfo = &appInfo;
+
+    VkInstance instance;
+    check(vkCreateInstance(&createInfo, nullptr, &instance), "vkCreateInstance");
+
+    return instance;
+}
+
+static VkDevice createDevice(VkPhysicalDevice physicalDevice, uint32_t queueFamily) {
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queueInfo = {VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO};
+    queueInfo.queueFamilyIndex = queueFamily;
+    queueInfo.queueCount = 1;
+    queueInfo.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo createInfo = {VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO};
+    createInfo.queueCreateInfoCount = 1;
+    createInfo.pQueueCreateInfos = &queueInfo;
+
+    VkDevice device;
+    check(vkCreateDevice(physicalDevice, &createInfo, nullptr, &device), "vkCreateDevice");
+
+    return device;
+}
+
+static VkShaderModule createShaderModule(VkDevice device, const std::vector<uint32_t>& code) {
+    VkShaderModuleCreateInfo createInfo = {VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO};
+    createInfo.codeSize = code.size() * sizeof(uint32_t);
+    createInfo.pCode = code.data();
+
+    VkShaderModule shaderModule;
+    check(vkCreateShaderModule(device, &createInfo, nullptr, &shaderModule), "vkCreateShaderModule");
+
+    return shaderModule;
+}
+
+static VkPipeline createPipeline(VkDevice device, VkShaderModule shaderModule, VkPipelineLayout layout) {
+    VkComputePipelineCreateInfo createInfo = {VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO};
+    createInfo.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    createInfo.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+    createInfo.stage.module = shaderModule;
+    createInfo.stage.pName = "main";
+    createInfo.layout = layout;
+
+    // No pipeline cache, so every iteration pays for the full compile
+    VkPipeline pipeline;
+    check(vkCreateComputePipelines(device, VK_NULL_HANDLE, 1, &createInfo, nullptr, &pipeline), "vkCreateComputePipelines");
+
+    return pipeline;
+}
+
+static uint32_t findMemoryType(VkPhysicalDevice physicalDevice, uint32_t typeBits,
+    const std::vector<VkMemoryPropertyFlags>& preferredProperties) {
+    VkPhysicalDeviceMemoryProperties memoryProperties;
+    vkGetPhysicalDeviceMemoryProperties(physicalDevice, &memoryProperties);
+
+    for (auto properties : preferredProperties) {
+        for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++) {
+            if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties) {
+                return i;
+            }
+        }
+    }
+
+    throw std::runtime_error("No suitable memory type found.");
+}
+
+static VkDeviceMemory allocate(Context& context, VkMemoryRequirements requirements,
+    const std::vector<VkMemoryPropertyFlags>& preferredProperties) {
+    VkMemoryAllocateInfo allocateInfo = {VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO};
+    allocateInfo.allocationSize = requirements.size;
+    allocateInfo.memoryTypeIndex = findMemoryType(context.physicalDevice, requirements.memoryTypeBits, preferredProperties);
+
+    VkDeviceMemory memory;
+    check(vkAllocateMemory(context.device, &allocateInfo, nullptr, &memory), "vkAllocateMemory");
+
+    return memory;
+}
+
+static void pickPhysicalDevice(Context& context, int deviceIndex) {
+    uint32_t deviceCount = 0;
+    vkEnumeratePhysicalDevices(context.instance, &deviceCount, nullptr);
+    std::vector<VkPhysicalDevice> devices(deviceCount);
+    vkEnumeratePhysicalDevices(context.instance, &deviceCount, devices.data());
+
+    if (devices.empty()) {
+        throw std::runtime_error("No Vulkan devices found.");
+    }
+
+    if (deviceIndex >= 0) {
+        if (static_cast<size_t>(deviceIndex) >= devices.size()) {
+            throw std::runtime_error("Device index out of range.");
+        }
+
+        context.physicalDevice = devices[deviceIndex];
+    } else {
+        // Without a choice, prefer a software driver such as lavapipe so results are comparable across machines
+        context.physicalDevice = devices[0];
+
+        for (auto device : devices) {
+            VkPhysicalDeviceProperties properties;
+            vkGetPhysicalDeviceProperties(device, &properties);
+
+            if (properties.deviceType == VK_PHYSICAL_DEVICE_TYPE_CPU) {
+                context.physicalDevice = device;
+                break;
+            }
+        }
+    }
+
+    vkGetPhysicalDeviceProperties(context.physicalDevice, &context.properties);
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(context.physicalDevice, &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(context.physicalDevice, &familyCount, families.data());
+
+    for (uint32_t i = 0; i < familyCount; i++) {
+        if (families[i].queueFlags & VK_QUEUE_COMPUTE_BIT) {
+            context.queueFamily = i;
+            return;
+        }
+    }
+
+    throw std::runtime_error("No compute queue family found.");
+}
+
+static Context createContext(const Options& options) {
+    Context context;
+
+    context.instance = createInstance();
+    pickPhysicalDevice(context, options.deviceIndex);
+
+    context.device = createDevice(context.physicalDevice, context.queueFamily);
+    vkGetDeviceQueue(context.device, context.queueFamily, 0, &context.queue);
+
+    VkCommandPoolCreateInfo poolInfo = {VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO};
+    poolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    poolInfo.queueFamilyIndex = context.queueFamily;
+    check(vkCreateCommandPool(context.device, &poolInfo, nullptr, &context.commandPool), "vkCreateCommandPool");
+
+    VkCommandBufferAllocateInfo allocateInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO};
+    allocateInfo.commandPool = context.commandPool;
+    allocateInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocateInfo.commandBufferCount = 1;
+    check(vkAllocateCommandBuffers(context.device, &allocateInfo, &context.commandBuffer), "vkAllocateCommandBuffers");
+
+    VkFenceCreateInfo fenceInfo = {VK_STRUCTURE_TYPE_FENCE_CREATE_INFO};
+    check(vkCreateFence(context.device, &fenceInfo, nullptr, &context.fence), "vkCreateFence");
+
+    // Compute pipeline with one storage buffer
+    context.shaderCode = readSpirv(BENCH_SHADER_PATH);
+    context.shaderModule = createShaderModule(context.device, context.shaderCode);
+
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    VkDescriptorSetLayoutCreateInfo setLayoutInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO};
+    setLayoutInfo.bindingCount = 1;
+    setLayoutInfo.pBindings = &binding;
+    check(vkCreateDescriptorSetLayout(context.device, &setLayoutInfo, nullptr, &context.setLayout),
+        "vkCreateDescriptorSetLayout");
+
+    VkPipelineLayoutCreateInfo pipelineLayoutInfo = {VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO};
+    pipelineLayoutInfo.setLayoutCount = 1;
+    pipelineLayoutInfo.pSetLayouts = &context.setLayout;
+    check(vkCreatePipelineLayout(context.device, &pipelineLayoutInfo, nullptr, &context.pipelineLayout),
+        "vkCreatePipelineLayout");
+
+    context.pipeline = createPipeline(context.device, context.shaderModule, context.pipelineLayout);
 
-const int WIDTH = 800;
-const int HEIGHT = 600;
+    // Storage buffer the recorded dispatches bind
+    VkBufferCreateInfo bufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    bufferInfo.size = STORAGE_SIZE;
+    bufferInfo.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    bufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    check(vkCreateBuffer(context.device, &bufferInfo, nullptr, &context.storageBuffer), "vkCreateBuffer");
 
-int main() {
-    glfwInit();
+    VkMemoryRequirements requirements;
+    vkGetBufferMemoryRequirements(context.device, context.storageBuffer, &requirements);
+    context.storageMemory = allocate(context, requirements, {VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, 0});
+    check(vkBindBufferMemory(context.device, context.storageBuffer, context.storageMemory, 0), "vkBindBufferMemory");
 
-    glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API);
-    GLFWwindow *window = glfwCreateWindow(WIDTH, HEIGHT, "Vulkan window", nullptr, nullptr);
+    VkDescriptorPoolSize poolSize = {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1};
+    VkDescriptorPoolCreateInfo descriptorPoolInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO};
+    descriptorPoolInfo.maxSets = 1;
+    descriptorPoolInfo.poolSizeCount = 1;
+    descriptorPoolInfo.pPoolSizes = &poolSize;
+    check(vkCreateDescriptorPool(context.device, &descriptorPoolInfo, nullptr, &context.descriptorPool),
+        "vkCreateDescriptorPool");
 
-    uint32_t extensionCount = 0;
-    vkEnumerateInstanceExtensionProperties(nullptr, &extensionCount, nullptr);
+    VkDescriptorSetAllocateInfo setAllocateInfo = {VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO};
+    setAllocateInfo.descriptorPool = context.descriptorPool;
+    setAllocateInfo.descriptorSetCount = 1;
+    setAllocateInfo.pSetLayouts = &context.setLayout;
+    check(vkAllocateDescriptorSets(context.device, &setAllocateInfo, &context.descriptorSet), "vkAllocateDescriptorSets");
 
-    std::cout << boost::format("%d extensions supported\n") % extensionCount;
+    VkDescriptorBufferInfo descriptorBuffer = {context.storageBuffer, 0, VK_WHOLE_SIZE};
+    VkWriteDescriptorSet write = {VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET};
+    write.dstSet = context.descriptorSet;
+    write.dstBinding = 0;
+    write.descriptorCount = 1;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.pBufferInfo = &descriptorBuffer;
+    vkUpdateDescriptorSets(context.device, 1, &write, 0, nullptr);
 
-    glm::mat4 matrix;
-    glm::vec4 vec;
-    auto test = matrix * vec;
+    // Host memory for map/flush, sized and typed for a staging buffer as an upload would use it.
+    // Cached memory is the case that actually needs the flush.
+    VkBufferCreateInfo hostBufferInfo = {VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO};
+    hostBufferInfo.size = MAP_SIZE;
+    hostBufferInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    hostBufferInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    check(vkCreateBuffer(context.device, &hostBufferInfo, nullptr, &context.hostBuffer), "vkCreateBuffer");
 
-    while(!glfwWindowShouldClose(window)) {
-        glfwPollEvents();
+    VkMemoryRequirements hostRequirements;
+    vkGetBufferMemoryRequirements(context.device, context.hostBuffer, &hostRequirements);
+    context.hostMemory = allocate(context, hostRequirements, {
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT,
+        VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
+    });
+    check(vkBindBufferMemory(context.device, context.hostBuffer, context.hostMemory, 0), "vkBindBufferMemory");
+
+    return context;
+}
+
+static void destroyContext(Context& context) {
+    vkDeviceWaitIdle(context.device);
+
+    vkDestroyBuffer(context.device, context.hostBuffer, nullptr);
+    vkFreeMemory(context.device, context.hostMemory, nullptr);
+    vkDestroyDescriptorPool(context.device, context.descriptorPool, nullptr);
+    vkDestroyBuffer(context.device, context.storageBuffer, nullptr);
+    vkFreeMemory(context.device, context.storageMemory, nullptr);
+    vkDestroyPipeline(context.device, context.pipeline, nullptr);
+    vkDestroyPipelineLayout(context.device, context.pipelineLayout, nullptr);
+    vkDestroyDescriptorSetLayout(context.device, context.setLayout, nullptr);
+    vkDestroyShaderModule(context.device, context.shaderModule, nullptr);
+    vkDestroyFence(context.device, context.fence, nullptr);
+    vkDestroyCommandPool(context.device, context.commandPool, nullptr);
+    vkDestroyDevice(context.device, nullptr);
+    vkDestroyInstance(context.instance, nullptr);
+}
+
+static std::vector<Benchmark> createBenchmarks(Context& context) {
+    std::vector<Benchmark> benchmarks;
+
+    benchmarks.push_back({"instance_create_destroy", 10, []() {
+        vkDestroyInstance(createInstance(), nullptr);
+    }});
+
+    benchmarks.push_back({"device_create_destroy", 10, [&context]() {
+        vkDestroyDevice(createDevice(context.physicalDevice, context.queueFamily), nullptr);
+    }});
+
+    benchmarks.push_back({"shader_module_create_destroy", 100, [&context]() {
+        vkDestroyShaderModule(context.device, createShaderModule(context.device, context.shaderCode), nullptr);
+    }});
+
+    benchmarks.push_back({"compute_pipeline_create_destroy", 20, [&context]() {
+        VkPipeline pipeline = createPipeline(context.device, context.shaderModule, context.pipelineLayout);
+        vkDestroyPipeline(context.device, pipeline, nullptr);
+    }});
+
+    benchmarks.push_back({"command_buffer_record", 1000, [&context]() {
+        VkCommandBufferBeginInfo beginInfo = {VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+        vkResetCommandBuffer(context.commandBuffer, 0);
+        check(vkBeginCommandBuffer(context.commandBuffer, &beginInfo), "vkBeginCommandBuffer");
+        vkCmdBindPipeline(context.commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, context.pipeline);
+        vkCmdBindDescriptorSets(context.commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, context.pipelineLayout,
+            0, 1, &context.descriptorSet, 0, nullptr);
+
+        for (uint32_t i = 0; i < RECORD_DISPATCHES; i++) {
+            vkCmdDispatch(context.commandBuffer, 1, 1, 1);
+        }
+
+        check(vkEndCommandBuffer(context.commandBuffer), "vkEndCommandBuffer");
+    }});
+
+    // A batch with no command buffers measures the submit path itself
+    static const VkSubmitInfo emptyBatch = {VK_STRUCTURE_TYPE_SUBMIT_INFO};
+
+    benchmarks.push_back({"empty_submit", 1000, [&context]() {
+        check(vkQueueSubmit(context.queue, 1, &emptyBatch, VK_NULL_HANDLE), "vkQueueSubmit");
+    }, []() {}, [&context]() {
+        check(vkQueueWaitIdle(context.queue), "vkQueueWaitIdle");
+    }});
+
+    benchmarks.push_back({"fence_round_trip", 1000, [&context]() {
+        check(vkQueueSubmit(context.queue, 1, &emptyBatch, context.fence), "vkQueueSubmit");
+        check(vkWaitForFences(context.device, 1, &context.fence, VK_TRUE, UINT64_MAX), "vkWaitForFences");
+        check(vkResetFences(context.device, 1, &context.fence), "vkResetFences");
+    }});
+
+    benchmarks.push_back({"memory_map_write_flush_64k", 1000, [&context]() {
+        void *data;
+        check(vkMapMemory(context.device, context.hostMemory, 0, VK_WHOLE_SIZE, 0, &data), "vkMapMemory");
+        std::memset(data, 0xab, MAP_SIZE);
+
+        VkMappedMemoryRange range = {VK_STRUCTURE_TYPE_MAPPED_MEMORY_RANGE};
+        range.memory = context.hostMemory;
+        range.offset = 0;
+        range.size = VK_WHOLE_SIZE;
+        check(vkFlushMappedMemoryRanges(context.device, 1, &range), "vkFlushMappedMemoryRanges");
+
+        vkUnmapMemory(context.device, context.hostMemory);
+    }});
+
+    return benchmarks;
+}
+
+static Result run(const Benchmark& benchmark, const Options& options) {
+    Result result = {benchmark.name, benchmark.iterations, {}};
+
+    for (int repetition = 0; repetition < options.warmup + options.repetitions; repetition++) {
+        benchmark.setup();
+
+        auto start = Clock::now();
+        for (size_t i = 0; i < benchmark.iterations; i++) {
+            benchmark.body();
+        }
+        std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+
+        benchmark.teardown();
+
+        // Warmup repetitions fill caches and let the driver settle; they are not recorded
+        if (repetition >= options.warmup) {
+            result.samples.push_back(elapsed.count() / benchmark.iterations);
+        }
+    }
+
+    return result;
+}
+
+struct Statistics {
+    double min;
+    double median;
+    double mean;
+    double max;
+    double stddev;
+};
+
+static Statistics summarize(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+
+    Statistics stats;
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.median = samples.size() % 2 == 1 ? samples[samples.size() / 2]
+        : (samples[samples.size() / 2 - 1] + samples[samples.size() / 2]) / 2.0;
+    stats.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+
+    double variance = 0.0;
+    for (double sample : samples) {
+        variance += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = std::sqrt(variance / samples.size());
+
+    return stats;
+}
+
+static std::string jsonString(const std::string& value) {
+    std::string result = "\"";
+
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            result += '\\';
+            result += c;
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            result += (boost::format("\\u%04x") % static_cast<int>(c)).str();
+        } else {
+            result += c;
+        }
+    }
+
+    return result + "\"";
+}
+
+static const char *deviceTypeName(VkPhysicalDeviceType type) {
+    switch (type) {
+        case VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU: return "integrated_gpu";
+        case VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU: return "discrete_gpu";
+        case VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU: return "virtual_gpu";
+        case VK_PHYSICAL_DEVICE_TYPE_CPU: return "cpu";
+        default: return "other";
+    }
+}
+
+static void writeJson(std::ostream& out, const Context& context, const Options& options,
+    const std::vector<Result>& results) {
+    const VkPhysicalDeviceProperties& properties = context.properties;
+
+    out << "{\n";
+    out << "  \"device\": {\n";
+    out << "    \"name\": " << jsonString(properties.deviceName) << ",\n";
+    out << "    \"type\": \"" << deviceTypeName(properties.deviceType) << "\",\n";
+    out << boost::format("    \"apiVersion\": \"%d.%d.%d\",\n") % VK_VERSION_MAJOR(properties.apiVersion)
+        % VK_VERSION_MINOR(properties.apiVersion) % VK_VERSION_PATCH(properties.apiVersion);
+    out << "    \"driverVersion\": " << properties.driverVersion << ",\n";
+    out << boost::format("    \"vendorId\": %d,\n    \"deviceId\": %d\n") % properties.vendorID % properties.deviceID;
+    out << "  },\n";
+    out << "  \"warmup\": " << options.warmup << ",\n";
+    out << "  \"repetitions\": " << options.repetitions << ",\n";
+    out << "  \"unit\": \"ns\",\n";
+    out << "  \"benchmarks\": [";
+
+    for (size_t i = 0; i < results.size(); i++) {
+        Statistics stats = summarize(results[i].samples);
+
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\n";
+        out << "      \"name\": " << jsonString(results[i].name) << ",\n";
+        out << "      \"iterations\": " << results[i].iterations << ",\n";
+        out << boost::format("      \"min\": %.1f,\n      \"median\": %.1f,\n      \"mean\": %.1f,\n")
+            % stats.min % stats.median % stats.mean;
+        out << boost::format("      \"max\": %.1f,\n      \"stddev\": %.1f,\n") % stats.max % stats.stddev;
+        out << "      \"samples\": [";
+
+        for (size_t sample = 0; sample < results[i].samples.size(); sample++) {
+            out << (sample == 0 ? "" : ", ") << boost::format("%.1f") % results[i].samples[sample];
+        }
+
+        out << "]\n    }";
+    }
+
+    out << "\n  ]\n}\n";
+}
+
+static void printUsage(const char *program) {
+    std::cerr << boost::format(
+        "Usage: %s [options]\n"
+        "  --warmup N        untimed repetitions before measuring (default 3)\n"
+        "  --repetitions N   timed repetitions per benchmark (default 10)\n"
+        "  --device N        physical device index (default: first CPU device, else device 0)\n"
+        "  --filter TEXT     only run benchmarks whose name contains TEXT\n"
+        "  --output FILE     write JSON results to FILE instead of stdout\n") % program;
+}
+
+static Options parseOptions(int argc, char **argv) {
+    Options options;
+
+    for (int i = 1; i < argc; i++) {
+        std::string argument = argv[i];
+
+        if (argument == "--help" || argument == "-h") {
+            printUsage(argv[0]);
+            std::exit(EXIT_SUCCESS);
+        }
+
+        if (i + 1 >= argc) {
+            printUsage(argv[0]);
+            throw std::runtime_error("Missing value for " + argument);
+        }
+
+        std::string value = argv[++i];
+
+        if (argument == "--warmup") {
+            options.warmup = std::stoi(value);
+        } else if (argument == "--repetitions") {
+            options.repetitions = std::stoi(value);
+        } else if (argument == "--device") {
+            options.deviceIndex = std::stoi(value);
+        } else if (argument == "--filter") {
+            options.filter = value;
+        } else if (argument == "--output") {
+            options.output = value;
+        } else {
+            printUsage(argv[0]);
+            throw std::runtime_error("Unknown option " + argument);
+        }
+    }
+
+    if (options.warmup < 0 || options.repetitions < 1) {
+        throw std::runtime_error("Warmup must be at least 0 and repetitions at least 1.");
     }
 
-    glfwDestroyWindow(window);
+    return options;
+}
+
+int main(int argc, char **argv) {
+    try {
+        Options options = parseOptions(argc, argv);
+        Context context = createContext(options);
 
-    glfwTerminate();
+        std::clog << boost::format("Device: %s\n") % context.properties.deviceName;
+        std::clog << boost::format("  %-34s %12s %12s %12s\n") % "benchmark" % "min ns" % "median ns" % "stddev ns";
+
+        std::vector<Result> results;
+        for (const auto& benchmark : createBenchmarks(context)) {
+            if (benchmark.name.find(options.filter) == std::string::npos) {
+                continue;
+            }
+
+            results.push_back(run(benchmark, options));
+
+            Statistics stats = summarize(results.back().samples);
+            std::clog << boost::format("  %-34s %12.1f %12.1f %12.1f\n") % benchmark.name % stats.min % stats.median % stats.stddev;
+        }
+
+        if (options.output.empty()) {
+            writeJson(std::cout, context, options, results);
+        } else {
+            std::ofstream file(options.output);
+
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open " + options.output);
+            }
+
+            writeJson(file, context, options, results);
+        }
+
+        destroyContext(context);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
 
-    return 0;
-}
\ No newline at end of file
+    return EXIT_SUCCESS;
+}